@@ -48,7 +48,7 @@ if (arg == "-h"):
     Print_Help()
 elif (arg == "local"):
     cmds = ["rm -f hydro.*",
-            "mpic++ -O3 " + srcs + " -I./src -I.. -o hydro.local -lm -fopenmp"]
+            "mpic++ -O3 -march=native " + srcs + " -I./src -I.. -o hydro.local -lm -fopenmp"]
 elif (arg == "mvs"):
     cmds = ["rm -f hydro.*",
             "mpicc -O3 " + srcs + " -I./src -I.. -o hydro.mvs -lm -fopenmp",
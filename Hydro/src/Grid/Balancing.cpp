@@ -0,0 +1,41 @@
+/**
+ * \file
+ * \brief Blocks ranks balancing mode functions realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Balancing.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Name of balancing mode.
+ *
+ * \param[in] balancing - balancing mode
+ *
+ * \return
+ * Name of balancing mode.
+ */
+string Balancing::Name(int balancing)
+{
+    switch (balancing)
+    {
+        case Cells:
+            return "Cells";
+
+        case Graph:
+            return "Graph";
+
+        case Circular:
+            return "Circular";
+
+        case Nodes:
+            return "Nodes";
+
+        default:
+            assert(false);
+    }
+}
+
+} }
@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \brief Blocks ranks balancing mode.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_GRID_BALANCING_H
+#define HYDRO_GRID_BALANCING_H
+
+#include <cassert>
+#include "Lib/IO/io.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Blocks ranks balancing mode.
+ *
+ * Blocks can be distributed between ranks in four ways:
+ * 1. The biggest block goes to the rank with the least count of cells
+ *    (interfaces are not taken into account).
+ * 2. Graph of blocks (vertices weighted by cells counts, edges weighted by cells counts
+ *    of interfaces shadows) is partitioned with minimal edge cut (count of MPI cells)
+ *    under tolerance of cells imbalance.
+ * 3. Blocks go to ranks in circular order of their numbers (sizes are not taken into account).
+ * 4. Graph of blocks is partitioned between nodes (minimal count of inter-node MPI cells),
+ *    then part of each node is partitioned between ranks of node.
+ */
+class Balancing
+{
+
+public:
+
+    /**
+     * \brief Balancing modes enumeration.
+     */
+    enum
+    {
+        Cells = 0,    /**< greedy cells balancing */
+        Graph = 1,    /**< multilevel graph partitioning */
+        Circular = 2, /**< circular distribution */
+        Nodes = 3,    /**< two-level graph partitioning (nodes, then ranks of node) */
+        Count = 4     /**< count of balancing modes */
+    };
+
+    // Functions.
+    static string Name(int balancing);
+
+private:
+
+};
+
+} }
+
+#endif
@@ -38,9 +38,16 @@ Block::Block(Grid *grid_p,
       K_Size_(k_size),
       Rank_(0),
       Nodes(NULL),
-      Cells(NULL)
+      Cells(NULL),
+      SoA(NULL),
+      Shadows(NULL),
+      Calc_Time_(0.0)
 {
-    Allocate_Memory();
+    // Planning grid has only layout of blocks.
+    if (!grid_p->Is_Planning())
+    {
+        Allocate_Memory();
+    }
 
     for (int i = 0; i < Direction::Count; i++)
     {
@@ -102,8 +109,25 @@ long Block::Bytes_Count() const
 {
     long doubles = (Nodes_Count() * 3
                    + Cells_Count() * 22);
+    long bytes = doubles * sizeof(double);
+
+    if (Shadows != NULL)
+    {
+        bytes += Shadows->Bytes_Count();
+    }
 
-    return doubles * sizeof(double);
+    return bytes;
+}
+
+/**
+ * \brief Add calculation time (can be called from several threads).
+ *
+ * \param[in] t - time
+ */
+void Block::Add_Calc_Time(double t)
+{
+    #pragma omp atomic
+    Calc_Time_ += t;
 }
 
 /**
@@ -319,6 +343,9 @@ int Block::Inner_Cells_Count() const
 /**
  * \brief Allocate memory.
  *
+ * Cells are allocated in storage mode of the grid,
+ * shadow layers are kept in structure of arrays form for both modes.
+ *
  * \return
  * true - if memory is allocated,
  * false - if memory is not allocated.
@@ -331,9 +358,20 @@ bool Block::Allocate_Memory()
     Deallocate_Memory();
 
     Nodes = new Point_3D[nodes_count];
-    Cells = new Cell[cells_count];
+    Shadows = new Shadow(this);
+
+    if (Get_Grid()->Storage() == Storage::SoA)
+    {
+        SoA = new Cells_SoA(cells_count);
+
+        return (Nodes != NULL) && (Shadows != NULL) && (SoA != NULL);
+    }
+    else
+    {
+        Cells = new Cell[cells_count];
 
-    return (Nodes != NULL) && (Cells != NULL);
+        return (Nodes != NULL) && (Shadows != NULL) && (Cells != NULL);
+    }
 }
 
 /**
@@ -341,14 +379,189 @@ bool Block::Allocate_Memory()
  */
 void Block::Deallocate_Memory()
 {
+    if (SoA != NULL)
+    {
+        delete SoA;
+        SoA = NULL;
+    }
+
     if (Cells != NULL)
     {
-        delete Cells;
+        delete [] Cells;
+        Cells = NULL;
     }
 
     if (Nodes != NULL)
     {
-        delete Nodes;
+        delete [] Nodes;
+        Nodes = NULL;
+    }
+
+    if (Shadows != NULL)
+    {
+        delete Shadows;
+        Shadows = NULL;
+    }
+}
+
+/**
+ * \brief Move cells data (structure of arrays) into given memory.
+ *
+ * Memory is not owned by block, it can be memory shared between processes:
+ * for own block data is copied there, for block of other process memory
+ * is just a view of its data (block of other process may have no cells memory).
+ *
+ * \param[in] memory_p - memory (Cells_SoA::Memory_Doubles_Count doubles,
+ *                       NULL - own memory of block is allocated)
+ * \param[in] is_copy - copy current data into memory
+ */
+void Block::Set_SoA_Memory(double *memory_p,
+                           bool is_copy)
+{
+    assert(Is_SoA() || !is_copy);
+
+    Cells_SoA *soa_p = (memory_p != NULL)
+                       ? new Cells_SoA(Cells_Count(), memory_p)
+                       : new Cells_SoA(Cells_Count());
+
+    if (is_copy)
+    {
+        soa_p->Copy(SoA);
+    }
+
+    delete SoA;
+    SoA = soa_p;
+}
+
+/*
+ * Migration.
+ */
+
+/**
+ * \brief Count of doubles of block data for migration.
+ *
+ * Shadows are not migrated (they are filled by the next exchange).
+ *
+ * \return
+ * Count of doubles.
+ */
+int Block::Migration_Doubles_Count() const
+{
+    return Nodes_Count() * 3 + Cells_Count() * Cells_SoA::Doubles_Per_Cell();
+}
+
+/**
+ * \brief Pack block data for migration.
+ *
+ * Nodes go first, then cells one by one (center, volume, squares and two layers),
+ * so data does not depend on cells storage mode.
+ *
+ * \param[out] buf_p - buffer (Migration_Doubles_Count doubles)
+ */
+void Block::Pack_Migration(double *buf_p) const
+{
+    for (int i = 0; i < Nodes_Count(); i++)
+    {
+        *buf_p++ = Nodes[i].X;
+        *buf_p++ = Nodes[i].Y;
+        *buf_p++ = Nodes[i].Z;
+    }
+
+    for (int c = 0; c < Cells_Count(); c++)
+    {
+        if (Is_SoA())
+        {
+            *buf_p++ = SoA->Center_X[c];
+            *buf_p++ = SoA->Center_Y[c];
+            *buf_p++ = SoA->Center_Z[c];
+            *buf_p++ = SoA->Vo[c];
+            for (int d = 0; d < Direction::Count; d++)
+            {
+                *buf_p++ = SoA->S[d][c];
+            }
+        }
+        else
+        {
+            const Cell *c_p = &Cells[c];
+
+            *buf_p++ = c_p->Center.X;
+            *buf_p++ = c_p->Center.Y;
+            *buf_p++ = c_p->Center.Z;
+            *buf_p++ = c_p->Vo;
+            for (int d = 0; d < Direction::Count; d++)
+            {
+                *buf_p++ = c_p->S[d];
+            }
+        }
+
+        for (int l = 0; l < 2; l++)
+        {
+            Fluid_Dyn_Pars u;
+
+            Get_U(c, l, u);
+            *buf_p++ = u.R;
+            *buf_p++ = u.V.X;
+            *buf_p++ = u.V.Y;
+            *buf_p++ = u.V.Z;
+            *buf_p++ = u.E;
+            *buf_p++ = u.P;
+        }
+    }
+}
+
+/**
+ * \brief Unpack block data after migration (memory has to be allocated).
+ *
+ * \param[in] buf_p - buffer (filled by Pack_Migration)
+ */
+void Block::Unpack_Migration(const double *buf_p)
+{
+    for (int i = 0; i < Nodes_Count(); i++)
+    {
+        Nodes[i].X = *buf_p++;
+        Nodes[i].Y = *buf_p++;
+        Nodes[i].Z = *buf_p++;
+    }
+
+    for (int c = 0; c < Cells_Count(); c++)
+    {
+        if (Is_SoA())
+        {
+            SoA->Center_X[c] = *buf_p++;
+            SoA->Center_Y[c] = *buf_p++;
+            SoA->Center_Z[c] = *buf_p++;
+            SoA->Vo[c] = *buf_p++;
+            for (int d = 0; d < Direction::Count; d++)
+            {
+                SoA->S[d][c] = *buf_p++;
+            }
+        }
+        else
+        {
+            Cell *c_p = &Cells[c];
+
+            c_p->Center.X = *buf_p++;
+            c_p->Center.Y = *buf_p++;
+            c_p->Center.Z = *buf_p++;
+            c_p->Vo = *buf_p++;
+            for (int d = 0; d < Direction::Count; d++)
+            {
+                c_p->S[d] = *buf_p++;
+            }
+        }
+
+        for (int l = 0; l < 2; l++)
+        {
+            Fluid_Dyn_Pars u;
+
+            u.R = *buf_p++;
+            u.V.X = *buf_p++;
+            u.V.Y = *buf_p++;
+            u.V.Z = *buf_p++;
+            u.E = *buf_p++;
+            u.P = *buf_p++;
+            Set_U(c, l, u);
+        }
     }
 }
 
@@ -386,7 +599,96 @@ Cell *Block::Get_Cell(int i,
                           int j,
                           int k)
 {
-    return &Cells[(k * J_Size() + j) * I_Size() + i];
+    return &Cells[Cell_Index(i, j, k)];
+}
+
+/**
+ * \brief Get fluid dynamic parameters of cell.
+ *
+ * \param[in] c - cell index
+ * \param[in] layer - layer
+ * \param[out] u - fluid dynamic parameters
+ */
+void Block::Get_U(int c,
+                  int layer,
+                  Fluid_Dyn_Pars &u) const
+{
+    if (Is_SoA())
+    {
+        SoA->U[layer].Get(c, u);
+    }
+    else
+    {
+        u = Cells[c].U[layer];
+    }
+}
+
+/**
+ * \brief Set fluid dynamic parameters of cell.
+ *
+ * \param[in] c - cell index
+ * \param[in] layer - layer
+ * \param[in] u - fluid dynamic parameters
+ */
+void Block::Set_U(int c,
+                  int layer,
+                  const Fluid_Dyn_Pars &u)
+{
+    if (Is_SoA())
+    {
+        SoA->U[layer].Set(c, u);
+    }
+    else
+    {
+        Cells[c].U[layer] = u;
+    }
+}
+
+/**
+ * \brief Copy fluid dynamic parameters of row of cells.
+ *
+ * Row of structure of arrays storage with unit stride is copied by arrays.
+ *
+ * \param[in] c - index of the first cell
+ * \param[in] stride - distance between cells of row
+ * \param[in] n - cells count
+ * \param[in] layer - layer
+ * \param[out] u - fluid dynamic parameters
+ */
+void Block::Get_Row(int c,
+                    int stride,
+                    int n,
+                    int layer,
+                    Fluid_Dyn_Arrays u) const
+{
+    if (Is_SoA())
+    {
+        const Fluid_Dyn_Arrays &s = SoA->U[layer];
+
+        if (stride == 1)
+        {
+            u.Copy(s.Shift(c), n);
+        }
+        else
+        {
+            for (int i = 0; i < n; i++, c += stride)
+            {
+                u.R[i] = s.R[c];
+                u.VX[i] = s.VX[c];
+                u.VY[i] = s.VY[c];
+                u.VZ[i] = s.VZ[c];
+                u.E[i] = s.E[c];
+                u.P[i] = s.P[c];
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < n; i++, c += stride)
+        {
+            u.Set(i, Cells[c].U[layer]);
+        }
+    }
 }
 
 /**
@@ -434,11 +736,26 @@ void Block::Create_Solid_Descartes(double i_real_size,
         {
             for (int k = 0; k < k_size; k++)
             {
-                Cell *c_p = Get_Cell(i, j, k);
+                if (Is_SoA())
+                {
+                    int c = Cell_Index(i, j, k);
+
+                    SoA->Center_X[c] = di * (i + 0.5);
+                    SoA->Center_Y[c] = dj * (j + 0.5);
+                    SoA->Center_Z[c] = dk * (k + 0.5);
+                    SoA->Vo[c] = vo;
+                    SoA->S[Direction::I0][c] = SoA->S[Direction::I1][c] = dj * dk;
+                    SoA->S[Direction::J0][c] = SoA->S[Direction::J1][c] = di * dk;
+                    SoA->S[Direction::K0][c] = SoA->S[Direction::K1][c] = di * dj;
+                }
+                else
+                {
+                    Cell *c_p = Get_Cell(i, j, k);
 
-                c_p->Set_Center(di * (i + 0.5), dj * (j + 0.5), dk * (k + 0.5));
-                c_p->Vo = vo;
-                c_p->Set_Descartes_Edges_Squares(dj * dk, di * dk, di * dj);
+                    c_p->Set_Center(di * (i + 0.5), dj * (j + 0.5), dk * (k + 0.5));
+                    c_p->Vo = vo;
+                    c_p->Set_Descartes_Edges_Squares(dj * dk, di * dk, di * dj);
+                }
             }
         }
     }
@@ -450,8 +767,7 @@ void Block::Create_Solid_Descartes(double i_real_size,
         {
             for (int k = 0; k < k_size; k++)
             {
-                Cell *c_p = Get_Cell(i, j, k);
-                Fluid_Dyn_Pars &u = c_p->U[cur];
+                Fluid_Dyn_Pars u;
 
                 u.Set_RVP(1.225, 0.0, 0.0, 0.0, 1.0);
 
@@ -459,6 +775,8 @@ void Block::Create_Solid_Descartes(double i_real_size,
                 {
                     u.Set_RP(u.R * 1.2, u.P * 1.2);
                 }
+
+                Set_U(Cell_Index(i, j, k), cur, u);
             }
         }
     }
@@ -472,6 +790,20 @@ void Block::Copy_Cur_Layer_To_Nxt()
     int cur = Get_Grid()->Layer();
     int nxt = cur ^ 1;
 
+    if (Is_SoA())
+    {
+        int i_size = I_Size();
+
+        // Copy by rows.
+        #pragma omp parallel for
+        for (int r = 0; r < J_Size() * K_Size(); r++)
+        {
+            SoA->U[nxt].Shift(r * i_size).Copy(SoA->U[cur].Shift(r * i_size), i_size);
+        }
+
+        return;
+    }
+
     #pragma omp parallel for
     for (int i = 0; i < Cells_Count(); i++)
     {
@@ -489,6 +821,19 @@ void Block::Nxt_Normal_To_Expand()
     int cur = Get_Grid()->Layer();
     int nxt = cur ^ 1;
 
+    if (Is_SoA())
+    {
+        int i_size = I_Size();
+
+        #pragma omp parallel for
+        for (int r = 0; r < J_Size() * K_Size(); r++)
+        {
+            SoA->U[nxt].Shift(r * i_size).Normal_To_Expand(i_size);
+        }
+
+        return;
+    }
+
     #pragma omp parallel for
     for (int i = 0; i < Cells_Count(); i++)
     {
@@ -505,6 +850,19 @@ void Block::Nxt_Expand_To_Normal()
     int cur = Get_Grid()->Layer();
     int nxt = cur ^ 1;
 
+    if (Is_SoA())
+    {
+        int i_size = I_Size();
+
+        #pragma omp parallel for
+        for (int r = 0; r < J_Size() * K_Size(); r++)
+        {
+            SoA->U[nxt].Shift(r * i_size).Expand_To_Normal(i_size);
+        }
+
+        return;
+    }
+
     #pragma omp parallel for
     for (int i = 0; i < Cells_Count(); i++)
     {
@@ -16,6 +16,10 @@
 #include "Facet_J.h"
 #include "Facet_K.h"
 #include "Cell.h"
+#include "Cells_SoA.h"
+#include "Shadow.h"
+#include "Storage.h"
+#include "Box.h"
 
 using namespace std;
 
@@ -34,9 +38,15 @@ public:
     // Points.
     Point_3D *Nodes;
 
-    // Cells.
+    // Cells (array of structures storage).
     Cell *Cells;
 
+    // Cells (structure of arrays storage).
+    Cells_SoA *SoA;
+
+    // Shadow layers.
+    Shadow *Shadows;
+
     /*
      * Block interface.
      */
@@ -71,10 +81,24 @@ public:
     void Set_Rank(int rank) { Rank_ = rank; }
     Facet *Get_Facet(int i) const { return Facets_p_[i]; }
     Grid *Get_Grid() const { return Grid_p_; }
+    bool Is_SoA() const { return SoA != NULL; }
+    Box Get_Box() const { return Box(0, I_Size(), 0, J_Size(), 0, K_Size()); }
+
+    // Calculation time (accumulated by solver for rebalancing).
+    double Calc_Time() const { return Calc_Time_; }
+    void Add_Calc_Time(double t);
+    void Reset_Calc_Time() { Calc_Time_ = 0.0; }
 
     // Allocate/deallocate memory.
     bool Allocate_Memory();
     void Deallocate_Memory();
+    void Set_SoA_Memory(double *memory_p,
+                        bool is_copy);
+
+    // Migration of block data between ranks (nodes and cells).
+    int Migration_Doubles_Count() const;
+    void Pack_Migration(double *buf_p) const;
+    void Unpack_Migration(const double *buf_p);
 
     // Construct block.
     void Create_Solid_Descartes(double i_real_size,
@@ -84,6 +108,20 @@ public:
     // Get node and cell pointers.
     Point_3D *Get_Node(int i, int j, int k);
     Cell *Get_Cell(int i, int j, int k);
+    int Cell_Index(int i, int j, int k) const { return (k * J_Size() + j) * I_Size() + i; }
+
+    // Storage independent access to cells data.
+    void Get_U(int c,
+               int layer,
+               Fluid_Dyn_Pars &u) const;
+    void Set_U(int c,
+               int layer,
+               const Fluid_Dyn_Pars &u);
+    void Get_Row(int c,
+                 int stride,
+                 int n,
+                 int layer,
+                 Fluid_Dyn_Arrays u) const;
 
     // Other.
     void Copy_Cur_Layer_To_Nxt();
@@ -105,6 +143,9 @@ private:
     // Process rank.
     int Rank_;
 
+    // Accumulated calculation time.
+    double Calc_Time_;
+
     // Facets.
     Facet *Facets_p_[Direction::Count];
 
@@ -0,0 +1,175 @@
+/**
+ * \file
+ * \brief Box of cells realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Box.h"
+#include "Direction.h"
+#include <cassert>
+#include <algorithm>
+
+namespace Hydro { namespace Grid {
+
+/*
+ * Constructors/destructors.
+ */
+
+/**
+ * \brief Default constructor (empty box).
+ */
+Box::Box()
+    : I0(0),
+      I1(0),
+      J0(0),
+      J1(0),
+      K0(0),
+      K1(0)
+{
+}
+
+/**
+ * \brief Constructor.
+ *
+ * \param[in] i0 - first cell in i direction
+ * \param[in] i1 - cell after last in i direction
+ * \param[in] j0 - first cell in j direction
+ * \param[in] j1 - cell after last in j direction
+ * \param[in] k0 - first cell in k direction
+ * \param[in] k1 - cell after last in k direction
+ */
+Box::Box(int i0,
+         int i1,
+         int j0,
+         int j1,
+         int k0,
+         int k1)
+    : I0(i0),
+      I1(i1),
+      J0(j0),
+      J1(j1),
+      K0(k0),
+      K1(k1)
+{
+}
+
+/*
+ * Border.
+ */
+
+/**
+ * \brief Get layer of cells of box on the border of region.
+ *
+ * \param[in] region - region (box lays inside it)
+ * \param[in] d - direction of region border
+ * \param[out] border - layer of cells of box on the border
+ *
+ * \return
+ * true - if box touches the border,
+ * false - otherwise.
+ */
+bool Box::Get_Border(const Box &region,
+                     int d,
+                     Box &border) const
+{
+    border = *this;
+
+    switch (d)
+    {
+        case Direction::I0:
+            border.I0 = region.I0;
+            border.I1 = region.I0 + 1;
+            break;
+
+        case Direction::I1:
+            border.I0 = region.I1 - 1;
+            border.I1 = region.I1;
+            break;
+
+        case Direction::J0:
+            border.J0 = region.J0;
+            border.J1 = region.J0 + 1;
+            break;
+
+        case Direction::J1:
+            border.J0 = region.J1 - 1;
+            border.J1 = region.J1;
+            break;
+
+        case Direction::K0:
+            border.K0 = region.K0;
+            border.K1 = region.K0 + 1;
+            break;
+
+        case Direction::K1:
+            border.K0 = region.K1 - 1;
+            border.K1 = region.K1;
+            break;
+
+        default:
+            assert(false);
+    }
+
+    return (border.I0 >= I0) && (border.I1 <= I1)
+           && (border.J0 >= J0) && (border.J1 <= J1)
+           && (border.K0 >= K0) && (border.K1 <= K1);
+}
+
+/**
+ * \brief Split box into inner box and shell.
+ *
+ * Shell consists of six boxes (one for each direction, depth may differ),
+ * I boxes are full slabs, J boxes lay between them and K boxes lay between J ones,
+ * so all parts do not overlap and cover the box.
+ * Parts of thin box and parts with zero depth are empty.
+ *
+ * \param[in] depths - depths of shell (for all directions)
+ * \param[out] inner - inner box
+ * \param[out] shell - boxes of shell (array of Direction::Count boxes)
+ */
+void Box::Split_Shell(const int *depths,
+                      Box &inner,
+                      Box *shell) const
+{
+    for (int d = 0; d < Direction::Count; d++)
+    {
+        assert(depths[d] >= 0);
+    }
+
+    inner.I0 = std::min(I0 + depths[Direction::I0], I1);
+    inner.I1 = std::max(I1 - depths[Direction::I1], inner.I0);
+    inner.J0 = std::min(J0 + depths[Direction::J0], J1);
+    inner.J1 = std::max(J1 - depths[Direction::J1], inner.J0);
+    inner.K0 = std::min(K0 + depths[Direction::K0], K1);
+    inner.K1 = std::max(K1 - depths[Direction::K1], inner.K0);
+
+    shell[Direction::I0] = Box(I0, inner.I0, J0, J1, K0, K1);
+    shell[Direction::I1] = Box(inner.I1, I1, J0, J1, K0, K1);
+    shell[Direction::J0] = Box(inner.I0, inner.I1, J0, inner.J0, K0, K1);
+    shell[Direction::J1] = Box(inner.I0, inner.I1, inner.J1, J1, K0, K1);
+    shell[Direction::K0] = Box(inner.I0, inner.I1, inner.J0, inner.J1, K0, inner.K0);
+    shell[Direction::K1] = Box(inner.I0, inner.I1, inner.J0, inner.J1, inner.K1, K1);
+}
+
+/*
+ * Information.
+ */
+
+/**
+ * \brief Print information.
+ *
+ * \param[in] os - stream
+ * \param[in] box - box
+ */
+ostream &operator<<(ostream &os,
+                    const Box &box)
+{
+    os << "[" << box.I0 << ", " << box.I1 << ") x ["
+       << box.J0 << ", " << box.J1 << ") x ["
+       << box.K0 << ", " << box.K1 << ")";
+
+    return os;
+}
+
+} }
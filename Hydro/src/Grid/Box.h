@@ -0,0 +1,62 @@
+/**
+ * \file
+ * \brief Box of cells.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_GRID_BOX_H
+#define HYDRO_GRID_BOX_H
+
+#include "Lib/IO/io.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Box of cells (part of block index space).
+ *
+ * Box contains cells with indices i in [I0, I1), j in [J0, J1), k in [K0, K1).
+ * NB! Unlike interfaces coordinates box coordinates are cells, not nodes.
+ */
+class Box
+{
+
+public:
+
+    // Borders.
+    int I0, I1, J0, J1, K0, K1;
+
+    // Constructors/destructors.
+    Box();
+    Box(int i0,
+        int i1,
+        int j0,
+        int j1,
+        int k0,
+        int k1);
+
+    // Simple characteristics.
+    int I_Size() const { return I1 - I0; }
+    int J_Size() const { return J1 - J0; }
+    int K_Size() const { return K1 - K0; }
+    int Cells_Count() const { return Is_Empty() ? 0 : (I_Size() * J_Size() * K_Size()); }
+    bool Is_Empty() const { return (I_Size() <= 0) || (J_Size() <= 0) || (K_Size() <= 0); }
+
+    // Border layer.
+    bool Get_Border(const Box &region,
+                    int d,
+                    Box &border) const;
+
+    // Inner box and shell.
+    void Split_Shell(const int *depths,
+                     Box &inner,
+                     Box *shell) const;
+};
+
+// Print information.
+ostream &operator<<(ostream &os,
+                    const Box &box);
+
+} }
+
+#endif
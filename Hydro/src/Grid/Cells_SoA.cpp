@@ -0,0 +1,202 @@
+/**
+ * \file
+ * \brief Cells data in structure of arrays form realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include <cstring>
+#include <cassert>
+#include "Cells_SoA.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Alignment of arrays (in doubles, 64 bytes).
+ */
+#define HYDRO_GRID_CELLS_SOA_ALIGN 8
+
+/*
+ * Constructors/destructors.
+ */
+
+/**
+ * \brief Constructor.
+ *
+ * \param[in] count - count of cells
+ */
+Cells_SoA::Cells_SoA(int count)
+    : Center_X(NULL),
+      Center_Y(NULL),
+      Center_Z(NULL),
+      Vo(NULL),
+      Count_(count),
+      Stride_(0),
+      Memory_p_(NULL),
+      Is_Own_Memory_(true)
+{
+    for (int i = 0; i < Direction::Count; i++)
+    {
+        S[i] = NULL;
+    }
+
+    Allocate_Memory();
+}
+
+/**
+ * \brief Constructor on given memory.
+ *
+ * \param[in] count - count of cells
+ * \param[in] memory_p - memory (Memory_Doubles_Count(count) doubles, not owned by object)
+ */
+Cells_SoA::Cells_SoA(int count,
+                     double *memory_p)
+    : Center_X(NULL),
+      Center_Y(NULL),
+      Center_Z(NULL),
+      Vo(NULL),
+      Count_(count),
+      Stride_(0),
+      Memory_p_(NULL),
+      Is_Own_Memory_(false)
+{
+    for (int i = 0; i < Direction::Count; i++)
+    {
+        S[i] = NULL;
+    }
+
+    Set_Memory(memory_p);
+}
+
+/**
+ * \brief Default destructor.
+ */
+Cells_SoA::~Cells_SoA()
+{
+    Deallocate_Memory();
+}
+
+/*
+ * Simple data.
+ */
+
+/**
+ * \brief Count of doubles used for single cell.
+ *
+ * \return
+ * Count of doubles per cell.
+ */
+int Cells_SoA::Doubles_Per_Cell()
+{
+    // Center, volume, squares and two layers of parameters.
+    return 3 + 1 + Direction::Count + 2 * 6;
+}
+
+/**
+ * \brief Count of doubles of memory chunk (with alignment reserve).
+ *
+ * \param[in] count - count of cells
+ *
+ * \return
+ * Count of doubles.
+ */
+int Cells_SoA::Memory_Doubles_Count(int count)
+{
+    const int a = HYDRO_GRID_CELLS_SOA_ALIGN;
+
+    return Doubles_Per_Cell() * ((count + a - 1) / a * a) + a;
+}
+
+/**
+ * \brief Copy data of the same size object.
+ *
+ * \param[in] s_p - source
+ */
+void Cells_SoA::Copy(const Cells_SoA *s_p)
+{
+    assert(s_p->Count() == Count());
+
+    memcpy(Center_X, s_p->Center_X, Doubles_Per_Cell() * Stride() * sizeof(double));
+}
+
+/*
+ * Allocate/deallocate memory.
+ */
+
+/**
+ * \brief Allocate memory.
+ *
+ * \return
+ * true - if memory is allocated,
+ * false - if memory is not allocated.
+ */
+bool Cells_SoA::Allocate_Memory()
+{
+    Deallocate_Memory();
+
+    double *memory_p = new double[Memory_Doubles_Count(Count_)]();
+
+    if (memory_p == NULL)
+    {
+        return false;
+    }
+
+    Set_Memory(memory_p);
+
+    return true;
+}
+
+/**
+ * \brief Place arrays in memory.
+ *
+ * \param[in] memory_p - memory (Memory_Doubles_Count doubles)
+ */
+void Cells_SoA::Set_Memory(double *memory_p)
+{
+    const int a = HYDRO_GRID_CELLS_SOA_ALIGN;
+
+    Memory_p_ = memory_p;
+    Stride_ = (Count_ + a - 1) / a * a;
+
+    // Align first array, others are aligned because of stride.
+    long addr = reinterpret_cast<long>(Memory_p_);
+    long align_bytes = a * sizeof(double);
+    double *p = reinterpret_cast<double *>((addr + align_bytes - 1) / align_bytes * align_bytes);
+
+    Center_X = p;
+    p += Stride_;
+    Center_Y = p;
+    p += Stride_;
+    Center_Z = p;
+    p += Stride_;
+    Vo = p;
+    p += Stride_;
+    for (int i = 0; i < Direction::Count; i++)
+    {
+        S[i] = p;
+        p += Stride_;
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        U[i].Set_Memory(p, Stride_);
+        p += 6 * Stride_;
+    }
+}
+
+/**
+ * \brief Deallocate memory.
+ */
+void Cells_SoA::Deallocate_Memory()
+{
+    if (Memory_p_ != NULL)
+    {
+        if (Is_Own_Memory_)
+        {
+            delete [] Memory_p_;
+        }
+
+        Memory_p_ = NULL;
+    }
+}
+
+} }
@@ -0,0 +1,81 @@
+/**
+ * \file
+ * \brief Cells data in structure of arrays form.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_GRID_CELLS_SOA_H
+#define HYDRO_GRID_CELLS_SOA_H
+
+#include "Fluid_Dyn_Arrays.h"
+#include "Direction.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Cells data in structure of arrays form.
+ *
+ * The same data as in array of Cell objects, but each value
+ * is kept in separate contiguous array, so kernel which uses only
+ * few values of cell does not load the others.
+ * All arrays lay in one memory chunk, each array is aligned.
+ * Memory chunk can be given from outside (for example, shared between processes),
+ * then it is not deallocated with object.
+ */
+class Cells_SoA
+{
+
+public:
+
+    // Centers coordinates.
+    double *Center_X;
+    double *Center_Y;
+    double *Center_Z;
+
+    // Volumes.
+    double *Vo;
+
+    // Edges squares.
+    double *S[Direction::Count];
+
+    // Two layers of fluid dynamic parameters.
+    // Current and Next layers.
+    Fluid_Dyn_Arrays U[2];
+
+    // Constructors/destructors.
+    Cells_SoA(int count);
+    Cells_SoA(int count,
+              double *memory_p);
+    ~Cells_SoA();
+
+    // Simple data.
+    int Count() const { return Count_; }
+    int Stride() const { return Stride_; }
+    static int Doubles_Per_Cell();
+    static int Memory_Doubles_Count(int count);
+
+    // Copy data.
+    void Copy(const Cells_SoA *s_p);
+
+private:
+
+    // Count of cells.
+    int Count_;
+
+    // Distance between arrays (count of cells aligned up).
+    int Stride_;
+
+    // Memory (and flag of own memory).
+    double *Memory_p_;
+    bool Is_Own_Memory_;
+
+    // Allocate/deallocate memory.
+    bool Allocate_Memory();
+    void Deallocate_Memory();
+    void Set_Memory(double *memory_p);
+};
+
+} }
+
+#endif
@@ -37,6 +37,7 @@ public:
 
     // Functions.
     static string Name(int direction);
+    static bool Is_Negative(int direction) { return (direction & 1) == 0; }
 
 private:
 
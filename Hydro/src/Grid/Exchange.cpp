@@ -0,0 +1,44 @@
+/**
+ * \file
+ * \brief Interfaces exchange mode functions realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Exchange.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Name of exchange mode.
+ *
+ * \param[in] exchange - exchange mode
+ *
+ * \return
+ * Name of exchange mode.
+ */
+string Exchange::Name(int exchange)
+{
+    switch (exchange)
+    {
+        case Ifaces:
+            return "Ifaces";
+
+        case Peers:
+            return "Peers";
+
+        case Neighbors:
+            return "Neighbors";
+
+        case RMA:
+            return "RMA";
+
+        case Shared:
+            return "Shared";
+
+        default:
+            assert(false);
+    }
+}
+
+} }
@@ -0,0 +1,59 @@
+/**
+ * \file
+ * \brief Interfaces exchange mode.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_GRID_EXCHANGE_H
+#define HYDRO_GRID_EXCHANGE_H
+
+#include <cassert>
+#include "Lib/IO/io.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Interfaces exchange mode.
+ *
+ * Shadow data of interfaces between blocks of different ranks can be sent in two ways:
+ * 1. Separate message for each interface.
+ * 2. One message for each neighbour (peer) rank, all interfaces with this rank
+ *    are packed into one contiguous buffer.
+ * 3. The same buffers as in 2 are exchanged by one neighborhood collective operation
+ *    on distributed graph communicator of ranks (MPI-3).
+ * 4. The same buffers as in 2 are put by owners into receive parts of pools of peers,
+ *    which are exposed in MPI window (one-sided communications,
+ *    post/start/complete/wait synchronization).
+ * 5. Cells of blocks of ranks of the same node are placed in shared memory,
+ *    shadows from them are copied directly (as for blocks of the same rank),
+ *    interfaces with other nodes are exchanged as in 2.
+ */
+class Exchange
+{
+
+public:
+
+    /**
+     * \brief Exchange modes enumeration.
+     */
+    enum
+    {
+        Ifaces = 0,    /**< message for each interface */
+        Peers = 1,     /**< message for each peer rank */
+        Neighbors = 2, /**< neighborhood collective for peer ranks */
+        RMA = 3,       /**< one-sided put for each peer rank */
+        Shared = 4,    /**< shared memory inside node, peer ranks messages between nodes */
+        Count = 5      /**< count of exchange modes */
+    };
+
+    // Functions.
+    static string Name(int exchange);
+
+private:
+
+};
+
+} }
+
+#endif
@@ -8,6 +8,7 @@
 #include <cassert>
 #include "Lib/IO/io.h"
 #include "Facet.h"
+#include "Iface.h"
 
 namespace Hydro { namespace Grid {
 
@@ -91,6 +92,50 @@ bool Facet::Is_Iface(int i,
     return p->Is_Iface();
 }
 
+/**
+ * \brief Check if all cells of facet are covered by interfaces.
+ *
+ * \return
+ * true - if facet has interfaces only,
+ * false - if facet has other borders.
+ */
+bool Facet::Is_Ifaces_Only() const
+{
+    for (int i = 0; i < Size(); i++)
+    {
+        Border *p = Borders_p_[i];
+
+        if ((p == NULL) || !p->Is_Iface())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \brief Check if facet has interfaces with blocks of other ranks.
+ *
+ * \return
+ * true - if there are interfaces with blocks of other ranks,
+ * false - otherwise.
+ */
+bool Facet::Has_Remote_Ifaces() const
+{
+    for (int i = 0; i < Size(); i++)
+    {
+        Border *p = Borders_p_[i];
+
+        if ((p != NULL) && p->Is_Iface() && !static_cast<const Iface *>(p)->Is_NActive())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * \brief Get border symbol.
  *
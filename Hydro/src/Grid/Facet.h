@@ -40,6 +40,8 @@ public:
     // Information.
     bool Is_Iface(int i,
                   int j) const;
+    bool Is_Ifaces_Only() const;
+    bool Has_Remote_Ifaces() const;
     char Symbol(int bi) const;
     void Print(ostream &os) const;
 
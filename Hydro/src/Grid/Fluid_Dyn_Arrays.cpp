@@ -0,0 +1,187 @@
+/**
+ * \file
+ * \brief Fluid Dynamic Parameters arrays realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include <cstring>
+#include <cassert>
+#include "Fluid_Dyn_Arrays.h"
+#include "Direction.h"
+
+namespace Hydro { namespace Grid {
+
+/*
+ * Constructors/destructors.
+ */
+
+/**
+ * \brief Default constructor.
+ */
+Fluid_Dyn_Arrays::Fluid_Dyn_Arrays()
+    : R(NULL),
+      VX(NULL),
+      VY(NULL),
+      VZ(NULL),
+      E(NULL),
+      P(NULL)
+{
+}
+
+/*
+ * Memory.
+ */
+
+/**
+ * \brief Set memory.
+ *
+ * Arrays are placed one after another.
+ *
+ * \param[in] p - memory pointer (6 * stride doubles)
+ * \param[in] stride - distance between arrays
+ */
+void Fluid_Dyn_Arrays::Set_Memory(double *p,
+                                  int stride)
+{
+    R = p;
+    VX = p + stride;
+    VY = p + 2 * stride;
+    VZ = p + 3 * stride;
+    E = p + 4 * stride;
+    P = p + 5 * stride;
+}
+
+/**
+ * \brief Get view of arrays which starts from given element.
+ *
+ * \param[in] n - number of element
+ *
+ * \return
+ * Shifted arrays.
+ */
+Fluid_Dyn_Arrays Fluid_Dyn_Arrays::Shift(int n) const
+{
+    Fluid_Dyn_Arrays a;
+
+    a.R = R + n;
+    a.VX = VX + n;
+    a.VY = VY + n;
+    a.VZ = VZ + n;
+    a.E = E + n;
+    a.P = P + n;
+
+    return a;
+}
+
+/**
+ * \brief Get view of arrays in frame of faces of given direction.
+ *
+ * Speed components are cyclically permuted, so VX of the view is normal
+ * to faces of direction d, and VY, VZ are tangential.
+ * Flows calculated in the view by rotated states land in right components.
+ *
+ * \param[in] d - direction
+ *
+ * \return
+ * Rotated arrays.
+ */
+Fluid_Dyn_Arrays Fluid_Dyn_Arrays::Rotate(int d) const
+{
+    Fluid_Dyn_Arrays a = *this;
+
+    switch (d)
+    {
+        case Direction::I0:
+        case Direction::I1:
+            break;
+
+        case Direction::J0:
+        case Direction::J1:
+            a.VX = VY;
+            a.VY = VZ;
+            a.VZ = VX;
+            break;
+
+        case Direction::K0:
+        case Direction::K1:
+            a.VX = VZ;
+            a.VY = VX;
+            a.VZ = VY;
+            break;
+
+        default:
+            assert(false);
+    }
+
+    return a;
+}
+
+/**
+ * \brief Copy elements from other arrays.
+ *
+ * \param[in] a - source arrays
+ * \param[in] count - count of elements
+ */
+void Fluid_Dyn_Arrays::Copy(const Fluid_Dyn_Arrays &a,
+                            int count)
+{
+    int bytes = count * sizeof(double);
+
+    memcpy(R, a.R, bytes);
+    memcpy(VX, a.VX, bytes);
+    memcpy(VY, a.VY, bytes);
+    memcpy(VZ, a.VZ, bytes);
+    memcpy(E, a.E, bytes);
+    memcpy(P, a.P, bytes);
+}
+
+/*
+ * Forms: normal <-> expand.
+ */
+
+/**
+ * \brief Convert normal form to expand.
+ *
+ * \param[in] count - count of elements
+ */
+void Fluid_Dyn_Arrays::Normal_To_Expand(int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        double r = R[i];
+        double vx = VX[i];
+        double vy = VY[i];
+        double vz = VZ[i];
+
+        E[i] = r * (E[i] + 0.5 * (vx * vx + vy * vy + vz * vz));
+        VX[i] = vx * r;
+        VY[i] = vy * r;
+        VZ[i] = vz * r;
+    }
+}
+
+/**
+ * \brief Convert expand form to normal.
+ *
+ * \param[in] count - count of elements
+ */
+void Fluid_Dyn_Arrays::Expand_To_Normal(int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        double r = R[i];
+        double vx = VX[i] / r;
+        double vy = VY[i] / r;
+        double vz = VZ[i] / r;
+        double e = E[i] / r - 0.5 * (vx * vx + vy * vy + vz * vz);
+
+        VX[i] = vx;
+        VY[i] = vy;
+        VZ[i] = vz;
+        E[i] = e;
+        P[i] = (Fluid_Dyn_Pars::Gamma - 1.0) * r * e;
+    }
+}
+
+} }
@@ -0,0 +1,96 @@
+/**
+ * \file
+ * \brief Fluid Dynamic Parameters arrays.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_GRID_FLUID_DYN_ARRAYS_H
+#define HYDRO_GRID_FLUID_DYN_ARRAYS_H
+
+#include "Fluid_Dyn_Pars.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Fluid Dynamic Parameters arrays.
+ *
+ * Structure of arrays form of Fluid_Dyn_Pars: each parameter is kept
+ * in its own contiguous array, element n of all arrays describes cell n.
+ * Object does not own memory, it is just a set of pointers,
+ * so it can be cheaply copied and shifted.
+ */
+class Fluid_Dyn_Arrays
+{
+
+public:
+
+    /*
+     * Data (not private because class it is just data container).
+     */
+
+    // Density.
+    double *R;
+
+    // Speed components.
+    double *VX;
+    double *VY;
+    double *VZ;
+
+    // Energy.
+    double *E;
+
+    // Pressure.
+    double *P;
+
+    /*
+     * Functions.
+     */
+
+    // Constructors/destructors.
+    Fluid_Dyn_Arrays();
+
+    // Set memory.
+    void Set_Memory(double *p,
+                    int stride);
+
+    // Shift (view of arrays from n-th element).
+    Fluid_Dyn_Arrays Shift(int n) const;
+
+    // Rotate (view of arrays with speed components in face frame).
+    Fluid_Dyn_Arrays Rotate(int d) const;
+
+    // Single element access.
+    void Get(int n,
+             Fluid_Dyn_Pars &u) const
+    {
+        u.R = R[n];
+        u.V.X = VX[n];
+        u.V.Y = VY[n];
+        u.V.Z = VZ[n];
+        u.E = E[n];
+        u.P = P[n];
+    }
+    void Set(int n,
+             const Fluid_Dyn_Pars &u)
+    {
+        R[n] = u.R;
+        VX[n] = u.V.X;
+        VY[n] = u.V.Y;
+        VZ[n] = u.V.Z;
+        E[n] = u.E;
+        P[n] = u.P;
+    }
+
+    // Copy elements.
+    void Copy(const Fluid_Dyn_Arrays &a,
+              int count);
+
+    // Forms: normal <-> expand.
+    void Normal_To_Expand(int count);
+    void Expand_To_Normal(int count);
+};
+
+} }
+
+#endif
@@ -85,7 +85,7 @@ public:
     // Flow.
     double DR_X() const { return R * V.X; }
     double DR_Y() const { return R * V.Y; }
-    double DR_Z() const { return R * V.Y; }
+    double DR_Z() const { return R * V.Z; }
     double DV_X() const { return R * V.X * V.X + P; }
     double DV_Y() const { return R * V.Y * V.Y + P; }
     double DV_Z() const { return R * V.Z * V.Z + P; }
@@ -9,11 +9,27 @@
 #include <fstream>
 #include <cassert>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 #include "Lib/MPI/mpi.h"
 #include "Grid.h"
+#include "Partitioner.h"
 
 namespace Hydro { namespace Grid {
 
+/**
+ * \brief Data of vector (NULL for empty vector).
+ *
+ * \param[in] v - vector
+ *
+ * \return
+ * Pointer to first element.
+ */
+static int *Data(vector<int> &v)
+{
+    return v.empty() ? NULL : &v[0];
+}
+
 /*
  * Constructors/destructors.
  */
@@ -26,7 +42,53 @@ Grid::Grid()
       Blocks_Count_(0),
       Ifaces_p_(NULL),
       Ifaces_Count_(0),
-      Layer_(0)
+      Shadows_Depth_(0),
+      Exchange_(Exchange::Ifaces),
+      Precision_(Precision::Double),
+      Precision_Keep_(Precision::Keep_None),
+      Ifaces_Buffers_(),
+      Peers_Pool_p_(NULL),
+      Ifaces_Wires_(),
+      Wire_Pool_p_(NULL),
+      Wire_Recv_Offset_(0),
+      Messages_(),
+      Neighbors_Comm_(MPI_COMM_NULL),
+      Neighbors_Send_Counts_(),
+      Neighbors_Send_Displs_(),
+      Neighbors_Recv_Counts_(),
+      Neighbors_Recv_Displs_(),
+      RMA_Win_(MPI_WIN_NULL),
+      RMA_Sources_Group_(MPI_GROUP_NULL),
+      RMA_Dests_Group_(MPI_GROUP_NULL),
+      Node_Comm_(MPI_COMM_NULL),
+      Shared_Win_(MPI_WIN_NULL),
+      Node_Ranks_(),
+      Shadows_Requests_(),
+      Shadows_Requests_Count_(0),
+      Recv_Ifaces_(),
+      Ifaces_Messages_(),
+      Ifaces_Unpacked_(),
+      Blocks_Waited_Ifaces_(),
+      Progress_Indices_(),
+      Time_(0.0),
+      Steps_Count_(0),
+      Min_Dt_(0.0),
+      Max_Dt_(0.0),
+      Layer_(0),
+      Storage_(Storage::AoS),
+      Balancing_(Balancing::Cells),
+      Balancing_Imbalance_(0.05),
+      Blocks_Splitting_(0),
+      Ranks_Per_Node_(0),
+      Ranks_Nodes_(),
+      Is_Planning_(false),
+      Partition_Name_(),
+      Rebalance_Checks_Count_(0),
+      Migrations_Count_(0),
+      Migrated_Blocks_Count_(0),
+      Migrated_Bytes_Count_(0),
+      Imbalance_Before_(0.0),
+      Imbalance_After_(0.0)
 {
     Init_Timers();
 }
@@ -36,10 +98,12 @@ Grid::Grid()
  */
 Grid::~Grid()
 {
+    Free_Ifaces_MPI_Data_Exchange();
     Deallocate_Blocks();
     Deallocate_Blocks_Pointers();
     Deallocate_Ifaces();
     Deallocate_Ifaces_Pointers();
+    Free_Shared_Memory();
 }
 
 /**
@@ -48,6 +112,22 @@ Grid::~Grid()
 void Grid::Init_Timers()
 {
     Timer_Shadow_Exchange_p_ = new Lib::MPI::Timer();
+    Timer_Shadow_Wait_p_ = new Lib::MPI::Timer();
+    Timer_Time_Step_p_ = new Lib::MPI::Timer();
+    Timer_Migration_p_ = new Lib::MPI::Timer();
+}
+
+/**
+ * \brief Register time step (physical time is moved forward).
+ *
+ * \param[in] dt - time step
+ */
+void Grid::Register_Time_Step(double dt)
+{
+    Time_ += dt;
+    Min_Dt_ = (Steps_Count_ == 0) ? dt : min(Min_Dt_, dt);
+    Max_Dt_ = (Steps_Count_ == 0) ? dt : max(Max_Dt_, dt);
+    Steps_Count_++;
 }
 
 /*
@@ -210,6 +290,29 @@ int Grid::MPI_Cells_Count() const
     return c * HYDRO_GRID_SHADOW_DEPTH;
 }
 
+/**
+ * \brief Get inter-node MPI cells count.
+ *
+ * \return
+ * Count of MPI cells of interfaces between ranks of different nodes.
+ */
+int Grid::Inter_Node_MPI_Cells_Count() const
+{
+    int c = 0;
+
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        Iface *p = Get_Iface(i);
+
+        if (Rank_Node(p->B()->Rank()) != Rank_Node(p->NB()->Rank()))
+        {
+            c += p->Cells_Count();
+        }
+    }
+
+    return c * HYDRO_GRID_SHADOW_DEPTH;
+}
+
 /*
  * Allocate/deallocate blocks.
  */
@@ -346,40 +449,104 @@ bool Grid::Load_GEOM(const string name,
     }
 
     int blocks_count;
+    vector<Block_Record> blocks;
+    vector<Iface_Record> ifaces;
 
-    // Read blocks count and allocate memory for pointers.
+    // Read blocks count and all blocks sizes.
     file_pfg >> blocks_count;
-    Allocate_Blocks_Pointers(blocks_count);
 
-    // Read all blocks.
     for (int i = 0; i < blocks_count; i++)
     {
         int i_size, j_size, k_size;
 
-        // Read block sizes and create block.
         file_pfg >> i_size >> j_size >> k_size;
-        Blocks_p_[i] = new Block(this, i, i_size - 1, j_size - 1, k_size - 1);
+        blocks.push_back(Block_Record(i_size - 1, j_size - 1, k_size - 1));
+    }
+
+    if (!Load_GEOM_Ifaces(file_ibc, ifaces))
+    {
+        cout << "Err: Interfaces loading failed." << endl;
+
+        return false;
+    }
+
+    if (!Check_GEOM_Ifaces(blocks, ifaces))
+    {
+        return false;
+    }
+
+    // Big blocks are split before ranks assignment.
+    if (Blocks_Splitting() > 0)
+    {
+        Split_Blocks(blocks, ifaces, ranks_count);
+    }
+
+    // Create blocks.
+    blocks_count = static_cast<int>(blocks.size());
+    Allocate_Blocks_Pointers(blocks_count);
+
+    for (int i = 0; i < blocks_count; i++)
+    {
+        const Block_Record &r = blocks[i];
+
+        Blocks_p_[i] = new Block(this, i, r.Sizes[0], r.Sizes[1], r.Sizes[2]);
+    }
+
+    // Blocks ranks from partition file or by balancing.
+    Init_Ranks_Nodes(ranks_count);
+    bool is_partition = !Partition_Name().empty()
+                        && Load_Partition(Partition_Name(), ranks_count);
+
+    if (!is_partition)
+    {
+        if (Balancing() == Balancing::Circular)
+        {
+            Set_Blocks_Ranks_Circular_Distribution(ranks_count);
+        }
+        else
+        {
+            Set_Blocks_Ranks_Cells_Balancing(ranks_count);
+        }
     }
 
-    // Blocks balancing.
-    Set_Blocks_Ranks_Cells_Balancing(ranks_count);
+    Create_Ifaces(ifaces);
+
+    // Graph of blocks is known only with interfaces.
+    if (!is_partition
+        && ((Balancing() == Balancing::Graph) || (Balancing() == Balancing::Nodes)))
+    {
+        if (Balancing() == Balancing::Graph)
+        {
+            Set_Blocks_Ranks_Graph_Partitioning(ranks_count, Balancing_Imbalance());
+        }
+        else
+        {
+            Set_Blocks_Ranks_Nodes_Partitioning(ranks_count, Balancing_Imbalance());
+        }
+
+        for (int i = 0; i < Ifaces_Count(); i++)
+        {
+            Get_Iface(i)->Update_Buffer();
+        }
+    }
 
     // Allocate memory for blocks.
     for (int i = 0; i < blocks_count; i++)
     {
         Block *p = Get_Block(i);
 
-        if (p->Is_Active())
+        if (p->Is_Active() && !Is_Planning())
         {
             p->Allocate_Memory();
         }
     }
+    Set_Ifaces_To_Facets();
+    Set_Ifaces_Pairs();
 
-    if (!Load_GEOM_Ifaces(file_ibc))
+    if (!Is_Planning())
     {
-        cout << "Err: Interfaces loading failed." << endl;
+        Init_Ifaces_MPI_Data_Exchange();
     }
-    Set_Ifaces_To_Facets();
 
     // Close files.
     file_pfg.close();
@@ -389,11 +556,121 @@ bool Grid::Load_GEOM(const string name,
 }
 
 /**
- * \brief Load Grid interfaces.
+ * \brief Load blocks ranks from partition file.
+ *
+ * File is made by Save_Partition (or by offline planner) for the same grid,
+ * count of ranks and blocks splitting.
+ *
+ * \param[in] name - name of file
+ * \param[in] ranks_count - count of ranks
+ *
+ * \return
+ * true - if blocks ranks are loaded,
+ * false - in other cases (blocks ranks are not changed).
+ */
+bool Grid::Load_Partition(const string name,
+                          int ranks_count)
+{
+    ifstream file;
+    string header;
+    int file_ranks_count, file_blocks_count, file_splitting;
+
+    file.open(name.c_str());
+    if (!file.is_open())
+    {
+        cout << "Err: Cannot open file: " << name << endl;
+
+        return false;
+    }
+
+    file >> header >> file_ranks_count >> file_blocks_count >> file_splitting;
+
+    if ((header != "partition")
+        || (file_ranks_count != ranks_count)
+        || (file_blocks_count != Blocks_Count())
+        || (file_splitting != Blocks_Splitting()))
+    {
+        cout << "Err: Partition " << name << " does not match grid (ranks " << ranks_count
+             << ", blocks " << Blocks_Count() << ", splitting " << Blocks_Splitting()
+             << ")." << endl;
+
+        return false;
+    }
+
+    vector<int> ranks(file_blocks_count, -1);
+
+    for (int i = 0; i < file_blocks_count; i++)
+    {
+        file >> ranks[i];
+
+        if (file.fail() || (ranks[i] < 0) || (ranks[i] >= ranks_count))
+        {
+            cout << "Err: Wrong rank of block " << i << " in partition " << name << endl;
+
+            return false;
+        }
+    }
+
+    for (int i = 0; i < file_blocks_count; i++)
+    {
+        Get_Block(i)->Set_Rank(ranks[i]);
+    }
+
+    file.close();
+
+    return true;
+}
+
+/**
+ * \brief Save blocks ranks into partition file.
+ *
+ * File keeps counts of ranks and blocks and blocks splitting for check on load,
+ * then ranks of blocks in order of their numbers.
+ *
+ * \param[in] name - name of file
+ * \param[in] ranks_count - count of ranks
+ *
+ * \return
+ * true - if file is saved,
+ * false - in other cases.
+ */
+bool Grid::Save_Partition(const string name,
+                          int ranks_count) const
+{
+    ofstream file;
+
+    file.open(name.c_str());
+    if (!file.is_open())
+    {
+        cout << "Err: Cannot open file: " << name << endl;
+
+        return false;
+    }
+
+    file << "partition" << endl;
+    file << ranks_count << " " << Blocks_Count() << " " << Blocks_Splitting() << endl;
+
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        file << Get_Block(i)->Rank() << endl;
+    }
+
+    file.close();
+
+    return true;
+}
+
+/**
+ * \brief Load Grid interfaces records.
+ *
+ * Records of interfaces with the same identifier are placed one after another,
+ * blocks numbers and nodes are converted to zero based.
  *
  * \param[in] s - stream
+ * \param[out] ifaces - interfaces records
  */
-bool Grid::Load_GEOM_Ifaces(ifstream &s)
+bool Grid::Load_GEOM_Ifaces(ifstream &s,
+                            vector<Iface_Record> &ifaces)
 {
     string tmp;
     int ifaces_count, pos;
@@ -402,24 +679,31 @@ bool Grid::Load_GEOM_Ifaces(ifstream &s)
     getline(s, tmp);
     getline(s, tmp);
 
-    // Read interfaces count and set up pointers.
+    // Read interfaces count and set up records.
     s >> ifaces_count;
-    Allocate_Ifaces_Pointers(ifaces_count);
+    ifaces.assign(ifaces_count, Iface_Record());
 
-    // First set null pointers.
-    for (int i = 0; i < ifaces_count; i++)
-    {
-        Ifaces_p_[i] = NULL;
-    }
+    // No records are read yet.
+    vector<bool> is_read(ifaces_count, false);
 
     // Read all interfaces.
     pos = 0;
     for (int iter = 0; iter < ifaces_count; iter++)
     {
-        int id, bid, i0, i1, j0, j1, k0, k1, nid;
+        Iface_Record r;
+        int id, bid, nid;
 
-        // Read interface parameters and create interface.
-        s >> id >> bid >> i0 >> i1 >> j0 >> j1 >> k0 >> k1 >> nid;
+        // Read interface parameters.
+        s >> id >> bid >> r.Lo[0] >> r.Hi[0] >> r.Lo[1] >> r.Hi[1] >> r.Lo[2] >> r.Hi[2] >> nid;
+        r.Id = id;
+        r.B = bid - 1;
+        r.NB = nid - 1;
+
+        for (int d = 0; d < 3; d++)
+        {
+            r.Lo[d]--;
+            r.Hi[d]--;
+        }
 
         // We are going to write interface to position "pos".
         // But if there is interface with the same id before,
@@ -429,11 +713,9 @@ bool Grid::Load_GEOM_Ifaces(ifstream &s)
         int cur_pos = -1;
         for (int i = 0; i < ifaces_count; i++)
         {
-            Iface *p = Get_Iface(i);
-
-            if (p != NULL)
+            if (is_read[i])
             {
-                if (p->Id() == id)
+                if (ifaces[i].Id == id)
                 {
                     cur_pos = i;
 
@@ -454,130 +736,564 @@ bool Grid::Load_GEOM_Ifaces(ifstream &s)
             pos += 2;
         }
 
-        Ifaces_p_[cur_pos] = new Iface(id,
-                                       Get_Block(bid - 1),
-                                       i0 - 1, i1 - 1, j0 - 1, j1 - 1, k0 - 1, k1 - 1,
-                                       Get_Block(nid - 1));
+        ifaces[cur_pos] = r;
+        is_read[cur_pos] = true;
     }
 
     return true;
 }
 
 /**
- * \brief Set ifaces pointers to facets.
- */
-void Grid::Set_Ifaces_To_Facets()
-{
-    // Analyze each iface.
-    for (int i = 0; i < Ifaces_Count(); i++)
-    {
-        Iface *i_p = Get_Iface(i);
-        Block *b_p = i_p->B();
-        Facet *f_p = b_p->Get_Facet(i_p->Direction());
-
-        f_p->Set_Iface(i_p);
-    }
-}
-
-/**
- * \brief Create Descartes grid with real sizes.
+ * \brief Check interfaces records of GEOM grid.
  *
- * We create grid where i - is x direction, j - y direction, k - z direction.
- * X interval is [0, i_real_size],
- * Y interval is [0, j_real_size],
- * Z interval is [0, k_real_size].
+ * Interfaces of pair have to be the same area on borders of both blocks.
+ * Shadow rows of pair are mapped with blocks axes supposed to be aligned,
+ * so pair with other orientation (permuted tangent axes) is not supported.
  *
- * \param[in] i_size - cells count in i direction
- * \param[in] j_size - cells count in j direction
- * \param[in] k_size - cells count in k direction
- * \param[in] i_real_size - size in meters in i direction
- * \param[in] j_real_size - size in meters in j direction
- * \param[in] k_real_size - size in meters in k direction
- */
-void Grid::Create_Solid_Descartes(int i_size,
-                                  int j_size,
-                                  int k_size,
-                                  double i_real_size,
-                                  double j_real_size,
-                                  double k_real_size)
-{
-    // Our grid has 1 block and no interfaces.
-    Allocate_Blocks_Pointers(1);
-    Blocks_p_[0] = new Block(this, 0, i_size, j_size, k_size);
-    Blocks_p_[0]->Create_Solid_Descartes(i_real_size, j_real_size, k_real_size);
-}
-
-/*
- * Information.
- */
-
-/**
- * \brief Print Grid information.
+ * \param[in] blocks - blocks records
+ * \param[in] ifaces - interfaces records (pairs go one after another)
  *
- * \param[in] os - stream
- * \param[in] grid_ - Grid pointer
+ * \return
+ * true - if all interfaces are supported,
+ * false - otherwise.
  */
-ostream &operator<<(ostream &os,
-                    const Grid *grid_p)
+bool Grid::Check_GEOM_Ifaces(const vector<Block_Record> &blocks,
+                             const vector<Iface_Record> &ifaces)
 {
-    int blocks_count = grid_p->Blocks_Count();
-    int ifaces_count = grid_p->Ifaces_Count();
-
-    os << "Grid(b" << blocks_count << ",i" << ifaces_count << "):" << endl;
+    int blocks_count = static_cast<int>(blocks.size());
+    int ifaces_count = static_cast<int>(ifaces.size());
 
-    for (int i = 0; i < blocks_count; i++)
+    for (int i = 0; i < ifaces_count; i += 2)
     {
-        Block *p = grid_p->Get_Block(i);
+        const Iface_Record &p = ifaces[i];
 
-        if (p != NULL)
+        if ((i + 1 == ifaces_count)
+            || (ifaces[i + 1].Id != p.Id)
+            || (ifaces[i + 1].B != p.NB) || (ifaces[i + 1].NB != p.B))
         {
-            os << p;
+            cout << "Err: Interface " << p.Id << " has no pair." << endl;
+
+            return false;
         }
-    }
 
-    for (int i = 0; i < ifaces_count; i++)
-    {
-        Iface *p = grid_p->Get_Iface(i);
+        for (int k = i; k < i + 2; k++)
+        {
+            const Iface_Record &r = ifaces[k];
+            bool is_border = (r.B >= 0) && (r.B < blocks_count) && (r.Axis() >= 0);
 
-        if (p != NULL)
+            for (int d = 0; is_border && (d < 3); d++)
+            {
+                is_border = (r.Lo[d] >= 0) && (r.Hi[d] <= blocks[r.B].Sizes[d]);
+            }
+
+            if (is_border)
+            {
+                int x = r.Axis();
+
+                is_border = (r.Lo[x] == 0) || (r.Lo[x] == blocks[r.B].Sizes[x]);
+            }
+
+            if (!is_border)
+            {
+                cout << "Err: Interface " << r.Id << " is not on border of block "
+                     << r.B << "." << endl;
+
+                return false;
+            }
+        }
+
+        if (!Is_Ifaces_Pair_Aligned(ifaces, i))
         {
-            os << p;
+            cout << "Err: Interface " << p.Id << " between blocks " << p.B << " and " << p.NB
+                 << " has unsupported orientation (blocks axes have to be aligned)." << endl;
+
+            return false;
         }
     }
-}
 
-/*
- * Blocks ranks balancing.
- */
+    return true;
+}
 
 /**
- * \brief Circular distribution of blocks ranks.
+ * \brief Check if blocks axes of interfaces pair are aligned.
  *
- * \param[in] ranks - ranks count
+ * Both interfaces have the same normal axis and the same sizes along each axis.
+ *
+ * \param[in] ifaces - interfaces records
+ * \param[in] i - number of first interface of pair
+ *
+ * \return
+ * true - if axes are aligned,
+ * false - otherwise.
  */
-void Grid::Set_Blocks_Ranks_Circular_Distribution(int ranks_count)
+bool Grid::Is_Ifaces_Pair_Aligned(const vector<Iface_Record> &ifaces,
+                                  int i)
 {
-    for (int i = 0; i < Blocks_Count(); i++)
+    const Iface_Record &p = ifaces[i];
+    const Iface_Record &q = ifaces[i + 1];
+
+    if (p.Axis() != q.Axis())
     {
-        Get_Block(i)->Set_Rank(i % ranks_count);
+        return false;
+    }
+
+    for (int d = 0; d < 3; d++)
+    {
+        if ((p.Hi[d] - p.Lo[d]) != (q.Hi[d] - q.Lo[d]))
+        {
+            return false;
+        }
     }
+
+    return true;
 }
 
 /**
- * \brief Balancing of blocks ranks.
+ * \brief Split big blocks (before ranks assignment).
  *
+ * Limit of block cells count is total cells count divided by count of ranks
+ * and by blocks splitting factor, each bigger block is recursively bisected
+ * along its longest axis (while halves are not thinner than shadow depth).
+ * Block having interfaces pair with non-aligned axes is not split
+ * (neighbour cut could not be mapped), count of such big blocks is reported.
+ *
+ * \param[in,out] blocks - blocks records
+ * \param[in,out] ifaces - interfaces records
  * \param[in] ranks_count - count of ranks
  */
-void Grid::Set_Blocks_Ranks_Cells_Balancing(int ranks_count)
+void Grid::Split_Blocks(vector<Block_Record> &blocks,
+                        vector<Iface_Record> &ifaces,
+                        int ranks_count) const
 {
-    int blocks_count = Blocks_Count();
+    long total = 0;
+    long parts = static_cast<long>(ranks_count) * Blocks_Splitting();
+    int next_id = 0;
+    int not_split_count = 0;
+    vector<bool> is_aligned(blocks.size(), true);
 
-    if (Is_Empty())
+    for (int b = 0; b < (int)blocks.size(); b++)
     {
-        return;
+        total += blocks[b].Cells_Count();
     }
 
-    // Allocate counters of cells count for each rank.
+    for (int i = 0; i < (int)ifaces.size(); i++)
+    {
+        next_id = max(next_id, ifaces[i].Id + 1);
+    }
+
+    for (int i = 0; i + 1 < (int)ifaces.size(); i += 2)
+    {
+        if (!Is_Ifaces_Pair_Aligned(ifaces, i))
+        {
+            is_aligned[ifaces[i].B] = false;
+            is_aligned[ifaces[i + 1].B] = false;
+        }
+    }
+
+    long max_cells = (total + parts - 1) / parts;
+
+    // New halves are appended to the end, so they are checked too.
+    for (int b = 0; b < (int)blocks.size(); b++)
+    {
+        if (!is_aligned[b] && (blocks[b].Cells_Count() > max_cells))
+        {
+            not_split_count++;
+
+            continue;
+        }
+
+        while (blocks[b].Cells_Count() > max_cells)
+        {
+            int x = 0;
+
+            for (int d = 1; d < 3; d++)
+            {
+                if (blocks[b].Sizes[d] > blocks[b].Sizes[x])
+                {
+                    x = d;
+                }
+            }
+
+            if (blocks[b].Sizes[x] < 2 * Shadow::Depth())
+            {
+                break;
+            }
+
+            Split_Block(blocks, ifaces, b, x, blocks[b].Sizes[x] / 2, next_id);
+            is_aligned.push_back(true);
+        }
+    }
+
+    if ((not_split_count > 0) && (Lib::MPI::Rank() == 0))
+    {
+        cout << "Wrn: " << not_split_count << " big blocks are not split "
+             << "(interfaces pairs with non-aligned axes)." << endl;
+    }
+}
+
+/**
+ * \brief Split block into two halves.
+ *
+ * Low half keeps block number, high half is appended.
+ * Interfaces of block are moved to the half they belong to (with shift of nodes
+ * for high half), interfaces crossing the cut are cut together with their pairs
+ * (pairs of block have to be aligned, so the cut axis is the same in neighbour block),
+ * new pair of interfaces is created at the cut.
+ *
+ * \param[in,out] blocks - blocks records
+ * \param[in,out] ifaces - interfaces records
+ * \param[in] b - block number
+ * \param[in] x - axis (0 - I, 1 - J, 2 - K)
+ * \param[in] c - cells count of low half along axis
+ * \param[in,out] next_id - identifier for new interfaces
+ */
+void Grid::Split_Block(vector<Block_Record> &blocks,
+                       vector<Iface_Record> &ifaces,
+                       int b,
+                       int x,
+                       int c,
+                       int &next_id)
+{
+    int hb = static_cast<int>(blocks.size());
+    Block_Record high = blocks[b];
+
+    high.Sizes[x] -= c;
+    blocks[b].Sizes[x] = c;
+    blocks.push_back(high);
+
+    // Pairs of interfaces (cut parts are appended and checked too).
+    for (int i = 0; i < (int)ifaces.size(); i += 2)
+    {
+        for (int k = 0; k < 2; k++)
+        {
+            int s = i + k;
+            int o = i + 1 - k;
+            int lo = ifaces[s].Lo[x];
+            int hi = ifaces[s].Hi[x];
+
+            if ((ifaces[s].B != b) || ((lo == hi) ? (lo == 0) : (hi <= c)))
+            {
+                // Not this block or low half.
+                continue;
+            }
+
+            if ((lo == hi) || (lo >= c))
+            {
+                // High half.
+                ifaces[s].B = hb;
+                ifaces[s].Lo[x] -= c;
+                ifaces[s].Hi[x] -= c;
+                ifaces[o].NB = hb;
+            }
+            else
+            {
+                // Interface is cut, high part and its pair are new pair.
+                assert(Is_Ifaces_Pair_Aligned(ifaces, i));
+
+                int oc = ifaces[o].Lo[x] + (c - lo);
+                Iface_Record sh = ifaces[s];
+                Iface_Record oh = ifaces[o];
+
+                ifaces[s].Hi[x] = c;
+                ifaces[o].Hi[x] = oc;
+                sh.Id = next_id;
+                sh.B = hb;
+                sh.Lo[x] = 0;
+                sh.Hi[x] = hi - c;
+                oh.Id = next_id;
+                oh.NB = hb;
+                oh.Lo[x] = oc;
+                next_id++;
+                ifaces.push_back((k == 0) ? sh : oh);
+                ifaces.push_back((k == 0) ? oh : sh);
+            }
+        }
+    }
+
+    // Interfaces of cut.
+    Iface_Record l, h;
+
+    l.Id = next_id;
+    l.B = b;
+    l.NB = hb;
+    h.Id = next_id;
+    h.B = hb;
+    h.NB = b;
+    next_id++;
+
+    for (int d = 0; d < 3; d++)
+    {
+        l.Hi[d] = h.Hi[d] = blocks[b].Sizes[d];
+    }
+
+    l.Lo[x] = l.Hi[x] = c;
+    h.Lo[x] = h.Hi[x] = 0;
+    ifaces.push_back(l);
+    ifaces.push_back(h);
+}
+
+/**
+ * \brief Create interfaces from records.
+ *
+ * \param[in] ifaces - interfaces records (pairs go one after another)
+ */
+void Grid::Create_Ifaces(const vector<Iface_Record> &ifaces)
+{
+    Allocate_Ifaces_Pointers(static_cast<int>(ifaces.size()));
+
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        const Iface_Record &r = ifaces[i];
+
+        Ifaces_p_[i] = new Iface(r.Id,
+                                 Get_Block(r.B),
+                                 r.Lo[0], r.Hi[0], r.Lo[1], r.Hi[1], r.Lo[2], r.Hi[2],
+                                 Get_Block(r.NB));
+    }
+}
+
+/**
+ * \brief Set ifaces pointers to facets.
+ */
+void Grid::Set_Ifaces_To_Facets()
+{
+    // Analyze each iface.
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        Iface *i_p = Get_Iface(i);
+        Block *b_p = i_p->B();
+        Facet *f_p = b_p->Get_Facet(i_p->Direction());
+
+        f_p->Set_Iface(i_p);
+    }
+}
+
+/**
+ * \brief Set pairs of interfaces.
+ *
+ * Interfaces with the same identifier are placed one after another.
+ */
+void Grid::Set_Ifaces_Pairs()
+{
+    for (int i = 0; i < Ifaces_Count(); i += 2)
+    {
+        Iface *p = Get_Iface(i);
+        Iface *q = Get_Iface(i + 1);
+
+        assert((p != NULL) && (q != NULL) && (p->Id() == q->Id()));
+        assert(p->Direction() / 2 == q->Direction() / 2);
+
+        p->Set_Pair(q);
+        q->Set_Pair(p);
+    }
+}
+
+/**
+ * \brief Create Descartes grid with real sizes.
+ *
+ * We create grid where i - is x direction, j - y direction, k - z direction.
+ * X interval is [0, i_real_size],
+ * Y interval is [0, j_real_size],
+ * Z interval is [0, k_real_size].
+ *
+ * \param[in] i_size - cells count in i direction
+ * \param[in] j_size - cells count in j direction
+ * \param[in] k_size - cells count in k direction
+ * \param[in] i_real_size - size in meters in i direction
+ * \param[in] j_real_size - size in meters in j direction
+ * \param[in] k_real_size - size in meters in k direction
+ */
+void Grid::Create_Solid_Descartes(int i_size,
+                                  int j_size,
+                                  int k_size,
+                                  double i_real_size,
+                                  double j_real_size,
+                                  double k_real_size)
+{
+    // Our grid has 1 block and no interfaces.
+    Allocate_Blocks_Pointers(1);
+    Blocks_p_[0] = new Block(this, 0, i_size, j_size, k_size);
+    Blocks_p_[0]->Create_Solid_Descartes(i_real_size, j_real_size, k_real_size);
+
+    // Exchange plan is empty, but blocks states of exchange are needed by overlap schedules.
+    Init_Ifaces_MPI_Data_Exchange();
+}
+
+/*
+ * Information.
+ */
+
+/**
+ * \brief Print Grid information.
+ *
+ * \param[in] os - stream
+ * \param[in] grid_ - Grid pointer
+ */
+ostream &operator<<(ostream &os,
+                    const Grid *grid_p)
+{
+    int blocks_count = grid_p->Blocks_Count();
+    int ifaces_count = grid_p->Ifaces_Count();
+
+    os << "Grid(b" << blocks_count << ",i" << ifaces_count << "):" << endl;
+
+    for (int i = 0; i < blocks_count; i++)
+    {
+        Block *p = grid_p->Get_Block(i);
+
+        if (p != NULL)
+        {
+            os << p;
+        }
+    }
+
+    for (int i = 0; i < ifaces_count; i++)
+    {
+        Iface *p = grid_p->Get_Iface(i);
+
+        if (p != NULL)
+        {
+            os << p;
+        }
+    }
+}
+
+/*
+ * Blocks ranks balancing.
+ */
+
+/**
+ * \brief Set blocks ranks balancing mode (before grid creation).
+ *
+ * \param[in] balancing - balancing mode
+ * \param[in] imbalance - tolerance of cells imbalance for graph partitioning
+ */
+void Grid::Set_Balancing(int balancing,
+                         double imbalance)
+{
+    assert(Is_Empty());
+    assert((balancing >= 0) && (balancing < Balancing::Count));
+
+    Balancing_ = balancing;
+    Balancing_Imbalance_ = imbalance;
+}
+
+/**
+ * \brief Set blocks splitting (before grid creation).
+ *
+ * \param[in] blocks_per_rank - count of blocks per rank which big blocks are split for
+ *                              (0 - no splitting)
+ */
+void Grid::Set_Blocks_Splitting(int blocks_per_rank)
+{
+    assert(Is_Empty());
+    assert(blocks_per_rank >= 0);
+
+    Blocks_Splitting_ = blocks_per_rank;
+}
+
+/**
+ * \brief Set count of ranks per node (before grid creation).
+ *
+ * Nodes are found by shared memory communicator by default,
+ * given count is used for planning of partitions for other runs.
+ *
+ * \param[in] ranks_per_node - count of ranks per node (0 - nodes are found by MPI)
+ */
+void Grid::Set_Ranks_Per_Node(int ranks_per_node)
+{
+    assert(Is_Empty());
+    assert(ranks_per_node >= 0);
+
+    Ranks_Per_Node_ = ranks_per_node;
+}
+
+/**
+ * \brief Get node of rank.
+ *
+ * \param[in] rank - rank
+ *
+ * \return
+ * Number of node (0 if nodes are not known).
+ */
+int Grid::Rank_Node(int rank) const
+{
+    return (rank < (int)Ranks_Nodes_.size()) ? Ranks_Nodes_[rank] : 0;
+}
+
+/**
+ * \brief Init nodes of ranks.
+ *
+ * Nodes are numbered in order of their first ranks.
+ * If count of ranks per node is not set then nodes are found by shared memory
+ * communicator (by all ranks of run), ranks of other run are on one node.
+ *
+ * \param[in] ranks_count - count of ranks
+ */
+void Grid::Init_Ranks_Nodes(int ranks_count)
+{
+    Ranks_Nodes_.assign(ranks_count, 0);
+
+    if (Ranks_Per_Node() > 0)
+    {
+        for (int i = 0; i < ranks_count; i++)
+        {
+            Ranks_Nodes_[i] = i / Ranks_Per_Node();
+        }
+    }
+    else if (ranks_count == Lib::MPI::Ranks_Count())
+    {
+        MPI_Comm node_comm;
+        int leader = Lib::MPI::Rank();
+        vector<int> leaders(ranks_count);
+
+        // Leader of node is its first rank.
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+        MPI_Bcast(&leader, 1, MPI_INT, 0, node_comm);
+        MPI_Comm_free(&node_comm);
+        MPI_Allgather(&leader, 1, MPI_INT, &leaders[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+        vector<int> nodes(leaders);
+
+        sort(nodes.begin(), nodes.end());
+        nodes.erase(unique(nodes.begin(), nodes.end()), nodes.end());
+
+        for (int i = 0; i < ranks_count; i++)
+        {
+            Ranks_Nodes_[i] = static_cast<int>(lower_bound(nodes.begin(), nodes.end(),
+                                                           leaders[i]) - nodes.begin());
+        }
+    }
+}
+
+/**
+ * \brief Circular distribution of blocks ranks.
+ *
+ * \param[in] ranks - ranks count
+ */
+void Grid::Set_Blocks_Ranks_Circular_Distribution(int ranks_count)
+{
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        Get_Block(i)->Set_Rank(i % ranks_count);
+    }
+}
+
+/**
+ * \brief Balancing of blocks ranks.
+ *
+ * \param[in] ranks_count - count of ranks
+ */
+void Grid::Set_Blocks_Ranks_Cells_Balancing(int ranks_count)
+{
+    int blocks_count = Blocks_Count();
+
+    if (Is_Empty())
+    {
+        return;
+    }
+
+    // Allocate counters of cells count for each rank.
     int *ranks_cells = new int[ranks_count];
 
     // Zero all counters.
@@ -614,143 +1330,1637 @@ void Grid::Set_Blocks_Ranks_Cells_Balancing(int ranks_count)
             }
         }
 
-        int emp_rank_num = 0;
+        int emp_rank_num = 0;
+
+        for (int i = 1; i < ranks_count; i++)
+        {
+            if (ranks_cells[i] < ranks_cells[emp_rank_num])
+            {
+                emp_rank_num = i;
+            }
+        }
+
+        // Put big_block_num block to emp_rank_num rank.
+        Get_Block(big_block_num)->Set_Rank(emp_rank_num);
+        ranks_cells[emp_rank_num] += big_block_size;
+    }
+
+    delete ranks_cells;
+}
+
+/**
+ * \brief Balancing of blocks ranks by graph partitioning.
+ *
+ * Blocks are vertices weighted by cells counts, interfaces are edges weighted by
+ * counts of their shadows cells, so edge cut is count of MPI cells.
+ * Interfaces have to be loaded.
+ *
+ * \param[in] ranks_count - count of ranks
+ * \param[in] imbalance - tolerance of cells imbalance (0.05 is 5 %)
+ */
+void Grid::Set_Blocks_Ranks_Graph_Partitioning(int ranks_count,
+                                               double imbalance)
+{
+    if (Is_Empty())
+    {
+        return;
+    }
+
+    Partitioner partitioner(Blocks_Count());
+    vector<int> ranks;
+
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        partitioner.Set_Vertex_Weight(i, Get_Block(i)->Cells_Count());
+    }
+
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        Iface *p = Get_Iface(i);
+
+        partitioner.Add_Edge(p->B()->Id(), p->NB()->Id(),
+                             p->Cells_Count() * HYDRO_GRID_SHADOW_DEPTH);
+    }
+
+    partitioner.Partition(ranks_count, imbalance, ranks);
+
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        Get_Block(i)->Set_Rank(ranks[i]);
+    }
+}
+
+/**
+ * \brief Balancing of blocks ranks by two-level graph partitioning.
+ *
+ * Graph of blocks is partitioned between nodes, so edge cut is count of inter-node
+ * MPI cells, then blocks of each node are partitioned between ranks of node
+ * (tolerance of imbalance is shared by levels).
+ * Nodes have to have equal counts of ranks, otherwise (or if one of levels is trivial)
+ * one-level graph partitioning is used.
+ * Interfaces have to be loaded.
+ *
+ * \param[in] ranks_count - count of ranks
+ * \param[in] imbalance - tolerance of cells imbalance (0.05 is 5 %)
+ */
+void Grid::Set_Blocks_Ranks_Nodes_Partitioning(int ranks_count,
+                                               double imbalance)
+{
+    if (Is_Empty())
+    {
+        return;
+    }
+
+    // Nodes are numbered by their first ranks, so the last rank may be on any node.
+    int nodes_count = 0;
+
+    for (int i = 0; i < ranks_count; i++)
+    {
+        nodes_count = max(nodes_count, Rank_Node(i) + 1);
+    }
+
+    vector<vector<int> > nodes_ranks(nodes_count);
+
+    for (int i = 0; i < ranks_count; i++)
+    {
+        nodes_ranks[Rank_Node(i)].push_back(i);
+    }
+
+    bool is_one_level = (nodes_count == 1) || (nodes_ranks[0].size() == 1);
+
+    for (int i = 0; i < nodes_count; i++)
+    {
+        is_one_level = is_one_level || (nodes_ranks[i].size() != nodes_ranks[0].size());
+    }
+
+    if (is_one_level)
+    {
+        Set_Blocks_Ranks_Graph_Partitioning(ranks_count, imbalance);
+
+        return;
+    }
+
+    // Levels imbalances give the whole tolerance.
+    double level_imbalance = sqrt(1.0 + imbalance) - 1.0;
+    Partitioner partitioner(Blocks_Count());
+    vector<int> nodes;
+
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        partitioner.Set_Vertex_Weight(i, Get_Block(i)->Cells_Count());
+    }
+
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        Iface *p = Get_Iface(i);
+
+        partitioner.Add_Edge(p->B()->Id(), p->NB()->Id(),
+                             p->Cells_Count() * HYDRO_GRID_SHADOW_DEPTH);
+    }
+
+    partitioner.Partition(nodes_count, level_imbalance, nodes);
+
+    // Blocks of node (with local numbers) are partitioned between ranks of node.
+    for (int n = 0; n < nodes_count; n++)
+    {
+        vector<int> locals(Blocks_Count(), -1);
+        vector<int> blocks;
+        vector<int> ranks;
+
+        for (int i = 0; i < Blocks_Count(); i++)
+        {
+            if (nodes[i] == n)
+            {
+                locals[i] = static_cast<int>(blocks.size());
+                blocks.push_back(i);
+            }
+        }
+
+        Partitioner node_partitioner(static_cast<int>(blocks.size()));
+
+        for (int i = 0; i < (int)blocks.size(); i++)
+        {
+            node_partitioner.Set_Vertex_Weight(i, Get_Block(blocks[i])->Cells_Count());
+        }
+
+        for (int i = 0; i < Ifaces_Count(); i++)
+        {
+            Iface *p = Get_Iface(i);
+            int a = locals[p->B()->Id()];
+            int b = locals[p->NB()->Id()];
+
+            if ((a >= 0) && (b >= 0))
+            {
+                node_partitioner.Add_Edge(a, b, p->Cells_Count() * HYDRO_GRID_SHADOW_DEPTH);
+            }
+        }
+
+        node_partitioner.Partition(static_cast<int>(nodes_ranks[n].size()), level_imbalance,
+                                   ranks);
+
+        for (int i = 0; i < (int)blocks.size(); i++)
+        {
+            Get_Block(blocks[i])->Set_Rank(nodes_ranks[n][ranks[i]]);
+        }
+    }
+}
+
+/*
+ * Dynamic rebalancing.
+ */
+
+/**
+ * \brief Check imbalance of blocks calculation times and rebalance blocks if it is big.
+ *
+ * Calculation times of blocks accumulated since the previous check are gathered,
+ * if imbalance of ranks times is above threshold then blocks are moved from the most
+ * loaded rank to the least loaded one while it decreases the maximum (so few blocks
+ * are migrated) and blocks are migrated if the new assignment is better.
+ * Times of blocks are reset.
+ * Has to be called by all ranks between iterations.
+ *
+ * \param[in] threshold - tolerance of imbalance (0.1 is 10 %)
+ *
+ * \return
+ * true - if blocks are migrated,
+ * false - if assignment is kept.
+ */
+bool Grid::Rebalance(double threshold)
+{
+    int ranks_count = Lib::MPI::Ranks_Count();
+    vector<double> times;
+    vector<int> ranks(Blocks_Count());
+    bool is_migrated = false;
+
+    Gather_Blocks_Calc_Times(times);
+
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        ranks[i] = Get_Block(i)->Rank();
+    }
+
+    Rebalance_Checks_Count_++;
+    Imbalance_Before_ = Calc_Times_Imbalance(times, ranks, ranks_count);
+    Imbalance_After_ = Imbalance_Before_;
+
+    if (Imbalance_Before_ > threshold)
+    {
+        Plan_Rebalancing(times, ranks_count, ranks);
+
+        double imbalance = Calc_Times_Imbalance(times, ranks, ranks_count);
+
+        if (imbalance < Imbalance_Before_)
+        {
+            Imbalance_After_ = imbalance;
+            Migrate_Blocks(ranks);
+            is_migrated = true;
+        }
+    }
+
+    Reset_Blocks_Calc_Times();
+
+    return is_migrated;
+}
+
+/**
+ * \brief Migrate blocks to new ranks.
+ *
+ * Data of blocks (nodes and cells) is sent from old ranks to new ones
+ * (memory of sent blocks is freed), then interfaces buffers and exchange plan
+ * are rebuilt for new ranks.
+ * Shared memory of node is rebuilt too (blocks own their memory during migration).
+ * Has to be called by all ranks with the same ranks between iterations.
+ *
+ * \param[in] ranks - new ranks of blocks
+ */
+void Grid::Migrate_Blocks(const vector<int> &ranks)
+{
+    assert((int)ranks.size() == Blocks_Count());
+    assert(Shadows_Depth_ == 0);
+
+    int rank = Lib::MPI::Rank();
+    vector<double *> bufs(Blocks_Count(), static_cast<double *>(NULL));
+    vector<MPI_Request> reqs;
+
+    Timer_Migration()->Start();
+
+    // Messages of one pair of ranks go in order of blocks numbers, so tag is the same.
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        Block *b_p = Get_Block(i);
+        int from = b_p->Rank();
+        int to = ranks[i];
+        int n = b_p->Migration_Doubles_Count();
+
+        if (from == to)
+        {
+            continue;
+        }
+
+        Migrated_Blocks_Count_++;
+        Migrated_Bytes_Count_ += static_cast<long>(n) * sizeof(double);
+
+        if ((from == rank) || (to == rank))
+        {
+            MPI_Request req;
+
+            bufs[i] = new double[n];
+
+            if (from == rank)
+            {
+                b_p->Pack_Migration(bufs[i]);
+                MPI_Isend(bufs[i], n, MPI_DOUBLE, to, 0, MPI_COMM_WORLD, &req);
+            }
+            else
+            {
+                MPI_Irecv(bufs[i], n, MPI_DOUBLE, from, 0, MPI_COMM_WORLD, &req);
+            }
+
+            reqs.push_back(req);
+        }
+    }
+
+    if (!reqs.empty())
+    {
+        MPI_Waitall(static_cast<int>(reqs.size()), &reqs[0], MPI_STATUSES_IGNORE);
+    }
+
+    // Old exchange plan and shared memory are not valid for new ranks.
+    Free_Ifaces_MPI_Data_Exchange();
+
+    if (Shared_Win_ != MPI_WIN_NULL)
+    {
+        for (int i = 0; i < Blocks_Count(); i++)
+        {
+            Block *b_p = Get_Block(i);
+
+            if (Node_Ranks_[b_p->Rank()])
+            {
+                // Own blocks get own memory, views of blocks of other ranks are dropped.
+                if (b_p->Is_Active())
+                {
+                    b_p->Set_SoA_Memory(NULL, true);
+                }
+                else
+                {
+                    b_p->Deallocate_Memory();
+                }
+            }
+        }
+
+        Free_Shared_Memory();
+    }
+
+    // New ranks and data of received blocks.
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        Block *b_p = Get_Block(i);
+        bool is_recv = (bufs[i] != NULL) && (ranks[i] == rank);
+        bool is_sent = (bufs[i] != NULL) && (ranks[i] != rank);
+
+        b_p->Set_Rank(ranks[i]);
+
+        if (is_recv)
+        {
+            b_p->Allocate_Memory();
+            b_p->Unpack_Migration(bufs[i]);
+        }
+        else if (is_sent)
+        {
+            b_p->Deallocate_Memory();
+        }
+
+        if (bufs[i] != NULL)
+        {
+            delete [] bufs[i];
+        }
+    }
+
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        Get_Iface(i)->Update_Buffer();
+    }
+
+    Init_Ifaces_MPI_Data_Exchange();
+    Migrations_Count_++;
+    Timer_Migration()->Stop();
+}
+
+/**
+ * \brief Reset calculation times of blocks.
+ */
+void Grid::Reset_Blocks_Calc_Times()
+{
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        Get_Block(i)->Reset_Calc_Time();
+    }
+}
+
+/**
+ * \brief Gather calculation times of all blocks (each block is measured by its rank).
+ *
+ * \param[out] times - times of blocks
+ */
+void Grid::Gather_Blocks_Calc_Times(vector<double> &times) const
+{
+    vector<double> own(Blocks_Count(), 0.0);
+
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        Block *b_p = Get_Block(i);
+
+        if (b_p->Is_Active())
+        {
+            own[i] = b_p->Calc_Time();
+        }
+    }
+
+    times.assign(Blocks_Count(), 0.0);
+
+    if (!own.empty())
+    {
+        MPI_Allreduce(&own[0], &times[0], Blocks_Count(), MPI_DOUBLE, MPI_SUM,
+                      MPI_COMM_WORLD);
+    }
+}
+
+/**
+ * \brief Imbalance of ranks calculation times (maximum to average ratio minus 1).
+ *
+ * \param[in] times - times of blocks
+ * \param[in] ranks - ranks of blocks
+ * \param[in] ranks_count - count of ranks
+ *
+ * \return
+ * Imbalance (0.0 if there are no times).
+ */
+double Grid::Calc_Times_Imbalance(const vector<double> &times,
+                                  const vector<int> &ranks,
+                                  int ranks_count)
+{
+    vector<double> loads(ranks_count, 0.0);
+    double total = 0.0;
+
+    for (int i = 0; i < (int)times.size(); i++)
+    {
+        loads[ranks[i]] += times[i];
+        total += times[i];
+    }
+
+    if (total <= 0.0)
+    {
+        return 0.0;
+    }
+
+    return *max_element(loads.begin(), loads.end()) * ranks_count / total - 1.0;
+}
+
+/**
+ * \brief Plan blocks rebalancing by calculation times.
+ *
+ * The most loaded rank gives the block which minimizes the new maximum of it and
+ * the least loaded rank (the smallest block among equal ones), while the maximum decreases.
+ * All ranks get the same plan from the same times.
+ *
+ * \param[in] times - times of blocks
+ * \param[in] ranks_count - count of ranks
+ * \param[in,out] ranks - ranks of blocks (current and then new ones)
+ */
+void Grid::Plan_Rebalancing(const vector<double> &times,
+                            int ranks_count,
+                            vector<int> &ranks)
+{
+    int blocks_count = static_cast<int>(times.size());
+    vector<double> loads(ranks_count, 0.0);
+
+    for (int i = 0; i < blocks_count; i++)
+    {
+        loads[ranks[i]] += times[i];
+    }
+
+    // Each move decreases sorted loads, iterations are limited for safety.
+    for (int iter = 0; iter < blocks_count * ranks_count; iter++)
+    {
+        int h = static_cast<int>(max_element(loads.begin(), loads.end()) - loads.begin());
+        int l = static_cast<int>(min_element(loads.begin(), loads.end()) - loads.begin());
+        int best = -1;
+        double best_max = loads[h];
+
+        for (int i = 0; i < blocks_count; i++)
+        {
+            if ((ranks[i] != h) || (times[i] <= 0.0))
+            {
+                continue;
+            }
+
+            double m = max(loads[h] - times[i], loads[l] + times[i]);
+
+            if ((m < best_max) || ((best >= 0) && (m == best_max) && (times[i] < times[best])))
+            {
+                best = i;
+                best_max = m;
+            }
+        }
+
+        if (best < 0)
+        {
+            break;
+        }
+
+        ranks[best] = l;
+        loads[h] -= times[best];
+        loads[l] += times[best];
+    }
+}
+
+/*
+ * Calculations.
+ */
+
+/**
+ * \brief Calculate single iteration.
+ *
+ * Only shadow layers are exchanged (there is no solver in grid).
+ */
+void Grid::Calculate_Iteration()
+{
+    Exchange_Shadows();
+}
+
+/**
+ * \brief Calculate iterations.
+ *
+ * \param[in] n - iterations number
+ */
+void Grid::Calculate_Iterations(int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        cout << setw(3) << Lib::MPI::Rank() << " | iter: " << setw(5) << i;
+        Calculate_Iteration();
+        cout << " : done" << endl;
+    }
+}
+
+/**
+ * \brief Exchange shadow layers of blocks.
+ *
+ * Cells of blocks near interfaces are packed into buffers of interfaces
+ * (on rank of neighbour block), buffers are sent to ranks of self blocks,
+ * where shadow layers are filled by reflected cells and then by interfaces buffers.
+ * Only first layers needed by solver may be exchanged.
+ *
+ * \param[in] depth - count of exchanged layers
+ */
+void Grid::Exchange_Shadows(int depth)
+{
+    Start_Exchange_Shadows(depth);
+    Finish_Exchange_Shadows();
+}
+
+/**
+ * \brief Start exchange of shadow layers of blocks.
+ *
+ * Buffers are packed and sent, hard borders and interfaces between blocks of this rank
+ * are filled at once, interfaces with blocks of other ranks are filled
+ * by Finish_Exchange_Shadows.
+ * Interfaces between blocks of this rank do not use buffers, neighbour cells are copied
+ * directly into shadow layers by rows, rows of all such interfaces are shared between threads.
+ * Cells which do not use shadow layers may be calculated between these calls.
+ *
+ * \param[in] depth - count of exchanged layers
+ */
+void Grid::Start_Exchange_Shadows(int depth)
+{
+    assert((depth > 0) && (depth <= Shadow::Depth()));
+    assert(Shadows_Depth_ == 0);
+
+    int ifaces_count = Ifaces_Count();
+    int layer = Layer();
+
+    Shadows_Depth_ = depth;
+
+    // Received interfaces are waited by their blocks until unpacking.
+    for (int k = 0; k < (int)Recv_Ifaces_.size(); k++)
+    {
+        int i = Recv_Ifaces_[k];
+
+        Ifaces_Unpacked_[i] = 0;
+        Blocks_Waited_Ifaces_[Get_Iface(i)->B()->Id()]++;
+    }
+
+    // Pack only for other ranks.
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < ifaces_count; i++)
+    {
+        Iface *p = Get_Iface(i);
+
+        if (Is_Send_Iface(p))
+        {
+            p->Pack(layer, depth, Ifaces_Buffers_[i]);
+
+            if (Precision() != Precision::Double)
+            {
+                Precision::Encode(Precision(), Precision_Keep(), p->Buffer(Ifaces_Buffers_[i]),
+                                  depth * p->Cells_Count(), p->Buffer_Cells_Count(),
+                                  Ifaces_Wires_[i]);
+            }
+        }
+    }
+
+    Ifaces_MPI_Data_Exchange_Start();
+
+    // Hard borders.
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        Block *b_p = Get_Block(i);
+
+        if (b_p->Is_Active())
+        {
+            b_p->Shadows->Reflect(layer, depth);
+        }
+    }
+
+    // Direct copy for interfaces between blocks of this rank (or node).
+    Local_Ifaces_.clear();
+    Local_Ifaces_Rows_.assign(1, 0);
+
+    for (int i = 0; i < ifaces_count; i++)
+    {
+        Iface *p = Get_Iface(i);
+
+        if (Is_Direct_Iface(p))
+        {
+            Local_Ifaces_.push_back(p);
+            Local_Ifaces_Rows_.push_back(Local_Ifaces_Rows_.back() + p->Rows_Count(depth));
+        }
+    }
+
+    int rows_count = Local_Ifaces_Rows_.back();
+
+    if (Exchange() == Exchange::Shared)
+    {
+        // Node blocks are ready after previous iteration on all ranks of node.
+        Sync_Node();
+    }
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int r = 0; r < rows_count; r++)
+    {
+        int n = static_cast<int>(upper_bound(Local_Ifaces_Rows_.begin(),
+                                             Local_Ifaces_Rows_.end(), r)
+                                 - Local_Ifaces_Rows_.begin()) - 1;
+
+        Local_Ifaces_[n]->Copy_Row(layer, r - Local_Ifaces_Rows_[n]);
+    }
+
+    if (Exchange() == Exchange::Shared)
+    {
+        // Node blocks are not changed until all ranks of node finish copy.
+        Sync_Node();
+    }
+}
+
+/**
+ * \brief Test exchange of shadow layers (helps MPI to progress messages).
+ *
+ * \return
+ * true - if all messages are delivered,
+ * false - otherwise.
+ */
+bool Grid::Test_Exchange_Shadows()
+{
+    assert(Shadows_Depth_ > 0);
+
+    if (Shadows_Requests_Count_ > 0)
+    {
+        int flag = 0;
+
+        if (Exchange() == Exchange::RMA)
+        {
+            MPI_Win_test(RMA_Win_, &flag);
+        }
+        else
+        {
+            MPI_Testall(Shadows_Requests_Count_, &Shadows_Requests_[0], &flag,
+                        MPI_STATUSES_IGNORE);
+        }
+
+        if (flag != 0)
+        {
+            // Delivery is seen.
+            Shadows_Requests_Count_ = 0;
+            Timer_Shadow_Exchange()->Stop();
+        }
+    }
+
+    return Shadows_Requests_Count_ == 0;
+}
+
+/**
+ * \brief Progress exchange of shadow layers of blocks.
+ *
+ * Tests messages and unpacks interfaces of each delivered message at once
+ * (for neighborhood collective and RMA exchange all interfaces are unpacked together),
+ * blocks are ready when all their interfaces are unpacked.
+ * Only one thread may call it during the exchange, other threads may calculate blocks
+ * (it is the only thread calling MPI, so MPI library has to support calls from any thread).
+ *
+ * \return
+ * true - if all interfaces are unpacked,
+ * false - otherwise.
+ */
+bool Grid::Progress_Exchange_Shadows()
+{
+    assert(Shadows_Depth_ > 0);
+
+    if (Shadows_Requests_Count_ == 0)
+    {
+        return true;
+    }
+
+    if ((Exchange() == Exchange::Neighbors) || (Exchange() == Exchange::RMA))
+    {
+        if (Test_Exchange_Shadows())
+        {
+            for (int k = 0; k < (int)Recv_Ifaces_.size(); k++)
+            {
+                Unpack_Iface(Recv_Ifaces_[k]);
+            }
+        }
+    }
+    else
+    {
+        int outcount;
+
+        Progress_Indices_.resize(Shadows_Requests_Count_);
+        MPI_Testsome(Shadows_Requests_Count_, &Shadows_Requests_[0],
+                     &outcount, &Progress_Indices_[0], MPI_STATUSES_IGNORE);
+
+        if (outcount == MPI_UNDEFINED)
+        {
+            // All messages are delivered before.
+            Shadows_Requests_Count_ = 0;
+            Timer_Shadow_Exchange()->Stop();
+        }
+        else
+        {
+            for (int j = 0; j < outcount; j++)
+            {
+                int m = Progress_Indices_[j];
+
+                if (Messages_[m].Is_Send)
+                {
+                    continue;
+                }
+
+                for (int k = 0; k < (int)Recv_Ifaces_.size(); k++)
+                {
+                    if (Ifaces_Messages_[Recv_Ifaces_[k]] == m)
+                    {
+                        Unpack_Iface(Recv_Ifaces_[k]);
+                    }
+                }
+            }
+        }
+    }
+
+    return Shadows_Requests_Count_ == 0;
+}
+
+/**
+ * \brief Check if all shadows of block are filled during exchange.
+ *
+ * \param[in] bi - block index
+ *
+ * \return
+ * true - if all interfaces of block with other ranks are unpacked,
+ * false - otherwise.
+ */
+bool Grid::Is_Block_Shadows_Ready(int bi) const
+{
+    int waited;
+
+    #pragma omp atomic read
+    waited = Blocks_Waited_Ifaces_[bi];
+
+    if (waited > 0)
+    {
+        return false;
+    }
+
+    // Shadows data is seen after the counter.
+    #pragma omp flush
+
+    return true;
+}
+
+/**
+ * \brief Finish exchange of shadow layers of blocks.
+ *
+ * Waits for messages and fills shadows of interfaces with blocks of other ranks
+ * (interfaces unpacked by exchange progress are skipped).
+ */
+void Grid::Finish_Exchange_Shadows()
+{
+    assert(Shadows_Depth_ > 0);
+
+    int recv_count = static_cast<int>(Recv_Ifaces_.size());
+
+    Ifaces_MPI_Data_Exchange_Wait();
+
+    // Unpack interfaces with blocks of other ranks.
+    #pragma omp parallel for schedule(dynamic)
+    for (int k = 0; k < recv_count; k++)
+    {
+        int i = Recv_Ifaces_[k];
+
+        if (Ifaces_Unpacked_[i] == 0)
+        {
+            Unpack_Iface(i);
+        }
+    }
+
+    Shadows_Depth_ = 0;
+}
+
+/**
+ * \brief Unpack received interface into shadows of its block.
+ *
+ * \param[in] i - interface index
+ */
+void Grid::Unpack_Iface(int i)
+{
+    Iface *p = Get_Iface(i);
+    int depth = Shadows_Depth_;
+
+    if (Precision() != Precision::Double)
+    {
+        Precision::Decode(Precision(), Precision_Keep(), Ifaces_Wires_[i],
+                          depth * p->Cells_Count(), p->Buffer_Cells_Count(),
+                          p->Buffer(Ifaces_Buffers_[i]));
+    }
+
+    p->Unpack(depth, Ifaces_Buffers_[i]);
+    Ifaces_Unpacked_[i] = 1;
+
+    // Shadows data is written before the counter.
+    #pragma omp flush
+    #pragma omp atomic
+    Blocks_Waited_Ifaces_[p->B()->Id()]--;
+}
+
+/**
+ * \brief Check if rank is on the same node (for shared memory exchange).
+ *
+ * \param[in] rank - rank
+ *
+ * \return
+ * true - if blocks of rank are in shared memory of node,
+ * false - otherwise.
+ */
+bool Grid::Is_Node_Rank(int rank) const
+{
+    return (Exchange() == Exchange::Shared) && !Node_Ranks_.empty() && Node_Ranks_[rank];
+}
+
+/**
+ * \brief Check if interface shadows are copied directly from neighbour block cells.
+ *
+ * \param[in] p - interface
+ *
+ * \return
+ * true - if self block is active and neighbour block data is available,
+ * false - otherwise.
+ */
+bool Grid::Is_Direct_Iface(const Iface *p) const
+{
+    return p->Is_BActive() && (p->Is_NActive() || Is_Node_Rank(p->NB()->Rank()));
+}
+
+/**
+ * \brief Check if interface data has to be sent to other rank.
+ *
+ * \param[in] p - interface
+ *
+ * \return
+ * true - if neighbour block is active and self block is on other node (or other rank),
+ * false - otherwise.
+ */
+bool Grid::Is_Send_Iface(const Iface *p) const
+{
+    return !p->Is_BActive() && p->Is_NActive() && !Is_Node_Rank(p->B()->Rank());
+}
+
+/**
+ * \brief Check if interface data has to be received from other rank.
+ *
+ * \param[in] p - interface
+ *
+ * \return
+ * true - if self block is active and neighbour block is on other node (or other rank),
+ * false - otherwise.
+ */
+bool Grid::Is_Recv_Iface(const Iface *p) const
+{
+    return p->Is_BActive() && !p->Is_NActive() && !Is_Node_Rank(p->NB()->Rank());
+}
+
+/**
+ * \brief Init shared memory of node blocks.
+ *
+ * Ranks are grouped by nodes, each rank places cells of its blocks into shared
+ * window of node (blocks go in order of numbers), cells of blocks of other ranks
+ * of node become views of their memory.
+ * Only structure of arrays storage is supported.
+ * Has to be called by all ranks.
+ */
+void Grid::Init_Shared_Memory()
+{
+    assert(Storage() == Storage::SoA);
+
+    int rank = Lib::MPI::Rank();
+    int ranks_count = Lib::MPI::Ranks_Count();
+    int node_size;
+    MPI_Group world_group, node_group;
+
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &Node_Comm_);
+    MPI_Comm_size(Node_Comm_, &node_size);
+
+    // Ranks of node.
+    vector<int> node_ranks(node_size), world_ranks(node_size);
+
+    for (int i = 0; i < node_size; i++)
+    {
+        node_ranks[i] = i;
+    }
+
+    MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+    MPI_Comm_group(Node_Comm_, &node_group);
+    MPI_Group_translate_ranks(node_group, node_size, &node_ranks[0],
+                              world_group, &world_ranks[0]);
+    MPI_Group_free(&node_group);
+    MPI_Group_free(&world_group);
+    Node_Ranks_.assign(ranks_count, false);
+
+    for (int i = 0; i < node_size; i++)
+    {
+        Node_Ranks_[world_ranks[i]] = true;
+    }
+
+    // Own memory.
+    long doubles = 0;
+    double *base_p;
+
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        Block *b_p = Get_Block(i);
+
+        if (b_p->Rank() == rank)
+        {
+            doubles += Cells_SoA::Memory_Doubles_Count(b_p->Cells_Count());
+        }
+    }
+
+    MPI_Win_allocate_shared(doubles * sizeof(double), sizeof(double), MPI_INFO_NULL,
+                            Node_Comm_, &base_p, &Shared_Win_);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, Shared_Win_);
+
+    // Memory of node ranks.
+    vector<double *> bases(ranks_count, static_cast<double *>(NULL));
+    vector<long> offsets(ranks_count, 0);
+
+    for (int i = 0; i < node_size; i++)
+    {
+        MPI_Aint size;
+        int disp_unit;
+
+        MPI_Win_shared_query(Shared_Win_, i, &size, &disp_unit, &bases[world_ranks[i]]);
+    }
+
+    // Place blocks.
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        Block *b_p = Get_Block(i);
+        int r = b_p->Rank();
+
+        if (Node_Ranks_[r])
+        {
+            b_p->Set_SoA_Memory(bases[r] + offsets[r], r == rank);
+            offsets[r] += Cells_SoA::Memory_Doubles_Count(b_p->Cells_Count());
+        }
+    }
+
+    Sync_Node();
+}
+
+/**
+ * \brief Free shared memory of node blocks (blocks have to be deallocated before).
+ */
+void Grid::Free_Shared_Memory()
+{
+    int finalized = 0;
+
+    MPI_Finalized(&finalized);
+
+    if (!finalized)
+    {
+        if (Shared_Win_ != MPI_WIN_NULL)
+        {
+            MPI_Win_unlock_all(Shared_Win_);
+            MPI_Win_free(&Shared_Win_);
+        }
+
+        if (Node_Comm_ != MPI_COMM_NULL)
+        {
+            MPI_Comm_free(&Node_Comm_);
+        }
+    }
+
+    Shared_Win_ = MPI_WIN_NULL;
+    Node_Comm_ = MPI_COMM_NULL;
+    Node_Ranks_.clear();
+}
+
+/**
+ * \brief Synchronize ranks of node (memory of shared window is consistent after it).
+ */
+void Grid::Sync_Node()
+{
+    MPI_Win_sync(Shared_Win_);
+    MPI_Barrier(Node_Comm_);
+    MPI_Win_sync(Shared_Win_);
+}
+
+/**
+ * \brief Set interfaces exchange mode.
+ *
+ * Shared mode supports only structure of arrays storage (storage has to be set before),
+ * for other storage peers mode is set instead of it.
+ *
+ * \param[in] exchange - exchange mode
+ */
+void Grid::Set_Exchange(int exchange)
+{
+    assert((exchange >= 0) && (exchange < Exchange::Count));
+    assert(Shadows_Depth_ == 0);
+
+    if ((exchange == Exchange::Shared) && (Storage() != Storage::SoA))
+    {
+        if (Lib::MPI::Rank() == 0)
+        {
+            cout << "Err: Shared exchange mode needs structure of arrays storage, "
+                 << "peers mode is used instead of it." << endl;
+        }
+
+        exchange = Exchange::Peers;
+    }
+
+    Exchange_ = exchange;
+
+    if (!Is_Empty())
+    {
+        Init_Ifaces_MPI_Data_Exchange();
+    }
+}
+
+/**
+ * \brief Set precision of interfaces transfer.
+ *
+ * \param[in] precision - precision mode
+ * \param[in] keep - variables kept in double precision (Precision::Keep_* flags)
+ */
+void Grid::Set_Precision(int precision,
+                         int keep)
+{
+    assert((precision >= 0) && (precision < Precision::Count));
+    assert(Shadows_Depth_ == 0);
+
+    Precision_ = precision;
+    Precision_Keep_ = keep;
+
+    if (!Is_Empty())
+    {
+        Init_Ifaces_MPI_Data_Exchange();
+    }
+}
+
+/**
+ * \brief Init MPI data exchange for interfaces.
+ *
+ * Plan of exchange is built from interfaces table.
+ * In Ifaces mode each interface with block of other rank is sent in its own buffer.
+ * In Peers mode all interfaces with the same peer rank (in one direction) are placed
+ * into one contiguous part of common pool and sent by one message.
+ * Interfaces go in the table order, so both ranks see the same order in message.
+ * All sent messages are placed in pool before received ones.
+ * Persistent requests are created once for all messages, each exchange only starts them.
+ * For reduced precision interfaces data is encoded into separate wire pool
+ * (placed in the same order) and sent as bytes.
+ * In Neighbors mode messages of pool are described as distributed graph communicator
+ * (weighted by messages sizes, ranks are not reordered since blocks keep their ranks),
+ * each exchange is one neighborhood collective.
+ * In RMA mode received parts of pools are exposed in MPI window.
+ * In Shared mode interfaces with ranks of the same node are not in messages,
+ * other interfaces are exchanged as in Peers mode.
+ * Should be called again (by all ranks) if blocks ranks are changed.
+ */
+void Grid::Init_Ifaces_MPI_Data_Exchange()
+{
+    assert(Shadows_Requests_Count_ == 0);
+
+    Free_Ifaces_MPI_Data_Exchange();
+
+    if ((Exchange() == Exchange::Shared) && (Shared_Win_ == MPI_WIN_NULL))
+    {
+        Init_Shared_Memory();
+    }
+
+    bool is_peers = (Exchange() != Exchange::Ifaces);
+    vector<int> msgs(Ifaces_Count(), -1);
+
+    Ifaces_Buffers_.assign(Ifaces_Count(), static_cast<double *>(NULL));
+
+    // Collect messages.
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        Iface *p = Get_Iface(i);
+        bool is_send;
+        int peer;
+
+        if (Is_Recv_Iface(p))
+        {
+            // Self block is active, neighbour is not.
+            // We have to receive data from neighbour block process.
+            is_send = false;
+            peer = p->NB()->Rank();
+        }
+        else if (Is_Send_Iface(p))
+        {
+            // Neighbour block is active, self is not.
+            // We have to send data to self block process.
+            is_send = true;
+            peer = p->B()->Rank();
+        }
+        else
+        {
+            // Data is copied without MPI or both blocks are not active.
+            continue;
+        }
+
+        int m = 0;
+
+        if (is_peers)
+        {
+            while ((m < (int)Messages_.size())
+                   && ((Messages_[m].Peer != peer) || (Messages_[m].Is_Send != is_send)))
+            {
+                m++;
+            }
+        }
+        else
+        {
+            m = static_cast<int>(Messages_.size());
+        }
+
+        if (m == (int)Messages_.size())
+        {
+            Messages_.push_back(Message(peer, is_send, is_peers ? 0 : p->Id()));
+            Messages_[m].Buffer_p = is_peers ? NULL : static_cast<double *>(p->MPI_Buffer());
+        }
+
+        Messages_[m].Ifaces_Count++;
+        Messages_[m].Doubles_Count += p->Buffer_Doubles_Count();
+        msgs[i] = m;
+        Ifaces_Buffers_[i] = static_cast<double *>(p->MPI_Buffer());
+
+        if (!is_send)
+        {
+            Recv_Ifaces_.push_back(i);
+        }
+    }
+
+    Ifaces_Messages_ = msgs;
+    Ifaces_Unpacked_.assign(Ifaces_Count(), 1);
+    Blocks_Waited_Ifaces_.assign(Blocks_Count(), 0);
+
+    // Place messages into pool.
+    if (is_peers)
+    {
+        vector<int> sizes(Ifaces_Count(), 0);
+        vector<int> msgs_offsets, ifaces_offsets;
+
+        for (int i = 0; i < Ifaces_Count(); i++)
+        {
+            sizes[i] = Get_Iface(i)->Buffer_Doubles_Count();
+        }
+
+        Peers_Pool_p_ = new double[Place_Messages(msgs, sizes, msgs_offsets, ifaces_offsets)];
+
+        for (int m = 0; m < (int)Messages_.size(); m++)
+        {
+            Messages_[m].Buffer_p = Peers_Pool_p_ + msgs_offsets[m];
+        }
+
+        for (int i = 0; i < Ifaces_Count(); i++)
+        {
+            if (msgs[i] >= 0)
+            {
+                Ifaces_Buffers_[i] = Peers_Pool_p_ + ifaces_offsets[i];
+            }
+        }
+    }
+
+    // Wire data (encoded buffers).
+    Ifaces_Wires_.assign(Ifaces_Count(), static_cast<char *>(NULL));
+
+    if (Precision() == Precision::Double)
+    {
+        for (int m = 0; m < (int)Messages_.size(); m++)
+        {
+            Messages_[m].Wire_p = reinterpret_cast<char *>(Messages_[m].Buffer_p);
+            Messages_[m].Wire_Bytes_Count = Messages_[m].Doubles_Count * sizeof(double);
+        }
+
+        for (int i = 0; i < Ifaces_Count(); i++)
+        {
+            Ifaces_Wires_[i] = reinterpret_cast<char *>(Ifaces_Buffers_[i]);
+        }
+    }
+    else
+    {
+        vector<int> sizes(Ifaces_Count(), 0);
+        vector<int> msgs_offsets, ifaces_offsets;
+
+        for (int i = 0; i < Ifaces_Count(); i++)
+        {
+            sizes[i] = Precision::Bytes_Count(Precision(), Precision_Keep(),
+                                              Get_Iface(i)->Buffer_Cells_Count());
+        }
+
+        Wire_Pool_p_ = new char[Place_Messages(msgs, sizes, msgs_offsets, ifaces_offsets)];
+
+        for (int m = 0; m < (int)Messages_.size(); m++)
+        {
+            Messages_[m].Wire_p = Wire_Pool_p_ + msgs_offsets[m];
+            Messages_[m].Wire_Bytes_Count = 0;
+        }
+
+        for (int i = 0; i < Ifaces_Count(); i++)
+        {
+            if (msgs[i] >= 0)
+            {
+                Ifaces_Wires_[i] = Wire_Pool_p_ + ifaces_offsets[i];
+                Messages_[msgs[i]].Wire_Bytes_Count += sizes[i];
+            }
+        }
+    }
+
+    Wire_Recv_Offset_ = 0;
+
+    for (int m = 0; m < (int)Messages_.size(); m++)
+    {
+        if (Messages_[m].Is_Send)
+        {
+            Wire_Recv_Offset_ += Messages_[m].Wire_Bytes_Count;
+        }
+    }
+
+    if (Exchange() == Exchange::Neighbors)
+    {
+        Init_Neighbors_Comm();
+
+        // Request of collective operation.
+        Shadows_Requests_.assign(1, MPI_REQUEST_NULL);
+
+        return;
+    }
+
+    if (Exchange() == Exchange::RMA)
+    {
+        Init_RMA_Window();
+
+        // Marker of epoch (only if there are peers).
+        Shadows_Requests_.assign(Messages_.empty() ? 0 : 1, MPI_REQUEST_NULL);
+
+        return;
+    }
+
+    // Persistent requests.
+    Shadows_Requests_.resize(Messages_.size());
+
+    for (int m = 0; m < (int)Messages_.size(); m++)
+    {
+        const Message &msg = Messages_[m];
+
+        if (msg.Is_Send)
+        {
+            MPI_Send_init(msg.Wire_p, Wire_Count(msg.Wire_Bytes_Count), Wire_Type(),
+                          msg.Peer, msg.Tag, MPI_COMM_WORLD, &Shadows_Requests_[m]);
+        }
+        else
+        {
+            MPI_Recv_init(msg.Wire_p, Wire_Count(msg.Wire_Bytes_Count), Wire_Type(),
+                          msg.Peer, msg.Tag, MPI_COMM_WORLD, &Shadows_Requests_[m]);
+        }
+    }
+}
+
+/**
+ * \brief Place messages and their interfaces data into pool.
+ *
+ * Sent messages go before received ones, interfaces of message go in the table order.
+ *
+ * \param[in] msgs - messages of interfaces (-1 if interface is not in any message)
+ * \param[in] sizes - sizes of interfaces data
+ * \param[out] msgs_offsets - offsets of messages in pool
+ * \param[out] ifaces_offsets - offsets of interfaces in pool
+ *
+ * \return
+ * Pool size.
+ */
+int Grid::Place_Messages(const vector<int> &msgs,
+                         const vector<int> &sizes,
+                         vector<int> &msgs_offsets,
+                         vector<int> &ifaces_offsets) const
+{
+    int msgs_count = static_cast<int>(Messages_.size());
+    vector<int> msgs_sizes(msgs_count, 0);
+    int off = 0;
+
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        if (msgs[i] >= 0)
+        {
+            msgs_sizes[msgs[i]] += sizes[i];
+        }
+    }
+
+    msgs_offsets.assign(msgs_count, 0);
 
-        for (int i = 1; i < ranks_count; i++)
+    for (int dir = 0; dir < 2; dir++)
+    {
+        for (int m = 0; m < msgs_count; m++)
         {
-            if (ranks_cells[i] < ranks_cells[emp_rank_num])
+            if (Messages_[m].Is_Send == (dir == 0))
             {
-                emp_rank_num = i;
+                msgs_offsets[m] = off;
+                off += msgs_sizes[m];
             }
         }
+    }
 
-        // Put big_block_num block to emp_rank_num rank.
-        Get_Block(big_block_num)->Set_Rank(emp_rank_num);
-        ranks_cells[emp_rank_num] += big_block_size;
+    vector<int> cur(msgs_offsets);
+
+    ifaces_offsets.assign(Ifaces_Count(), -1);
+
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        int m = msgs[i];
+
+        if (m >= 0)
+        {
+            ifaces_offsets[i] = cur[m];
+            cur[m] += sizes[i];
+        }
     }
 
-    delete ranks_cells;
+    return off;
 }
 
-/*
- * Calculations.
+/**
+ * \brief Init distributed graph communicator for neighborhood collective exchange.
+ *
+ * Sources of graph are ranks we receive messages from, destinations are ranks
+ * we send messages to, neighbours go in the order of messages.
+ * Counts and displacements are given in wire data units.
  */
+void Grid::Init_Neighbors_Comm()
+{
+    vector<int> sources, sources_weights, dests, dests_weights;
+    char *pool_p = Wire_Pool();
+
+    for (int m = 0; m < (int)Messages_.size(); m++)
+    {
+        const Message &msg = Messages_[m];
+        int count = Wire_Count(msg.Wire_Bytes_Count);
+        int displ = static_cast<int>(msg.Wire_p - pool_p);
+
+        if (msg.Is_Send)
+        {
+            dests.push_back(msg.Peer);
+            dests_weights.push_back(count);
+            Neighbors_Send_Counts_.push_back(count);
+            Neighbors_Send_Displs_.push_back(Wire_Count(displ));
+        }
+        else
+        {
+            sources.push_back(msg.Peer);
+            sources_weights.push_back(count);
+            Neighbors_Recv_Counts_.push_back(count);
+            Neighbors_Recv_Displs_.push_back(Wire_Count(displ - Wire_Recv_Offset_));
+        }
+    }
+
+    MPI_Dist_graph_create_adjacent(MPI_COMM_WORLD,
+                                   static_cast<int>(sources.size()),
+                                   Data(sources), Data(sources_weights),
+                                   static_cast<int>(dests.size()),
+                                   Data(dests), Data(dests_weights),
+                                   MPI_INFO_NULL, 0, &Neighbors_Comm_);
+}
 
 /**
- * \brief Calculate single iteration.
+ * \brief Init MPI window for RMA exchange.
+ *
+ * Window exposes received part of wire pool (displacements are in bytes).
+ * Each rank tells its sources where their data has to be placed,
+ * so owners can put data without any matching on receiver side.
+ * Single rank has no peers and does not need window.
  */
-void Grid::Calculate_Iteration()
+void Grid::Init_RMA_Window()
 {
-    // Set predefined values to buffers.
-    for (int i = 0; i < Ifaces_Count(); i++)
+    int ranks_count = Lib::MPI::Ranks_Count();
+
+    if (ranks_count == 1)
     {
-        Iface *p = Get_Iface(i);
+        return;
+    }
+    vector<int> recv_displs(ranks_count, -1);
+    vector<int> send_displs(ranks_count, -1);
+    vector<int> sources, dests;
+    char *recv_p = Wire_Pool() + Wire_Recv_Offset_;
+    int recv_bytes = 0;
+
+    for (int m = 0; m < (int)Messages_.size(); m++)
+    {
+        const Message &msg = Messages_[m];
 
-        if (p->Is_MPI())
+        if (msg.Is_Send)
         {
-            if (p->Is_BActive())
-            {
-                p->Set_Buffer_Value(0.0);
-            }
-            else
-            {
-                p->Set_Buffer_Value(1.0);
-            }
+            dests.push_back(msg.Peer);
+        }
+        else
+        {
+            sources.push_back(msg.Peer);
+            recv_displs[msg.Peer] = static_cast<int>(msg.Wire_p - recv_p);
+            recv_bytes += msg.Wire_Bytes_Count;
         }
     }
 
-    // Exchange.
-    Ifaces_MPI_Data_Exchange();
+    MPI_Alltoall(&recv_displs[0], 1, MPI_INT, &send_displs[0], 1, MPI_INT, MPI_COMM_WORLD);
 
-    // Check buffers.
-    for (int i = 0; i < Ifaces_Count(); i++)
+    for (int m = 0; m < (int)Messages_.size(); m++)
     {
-        Iface *p = Get_Iface(i);
-
-        if (p->Is_MPI())
+        if (Messages_[m].Is_Send)
         {
-            if (p->Is_BActive())
-            {
-                assert(p->Check_Buffer_Value(1.0, 0.001));
-            }
+            Messages_[m].Target_Displ = send_displs[Messages_[m].Peer];
+            assert(Messages_[m].Target_Displ >= 0);
         }
     }
+
+    MPI_Win_create(recv_p, recv_bytes, 1, MPI_INFO_NULL, MPI_COMM_WORLD, &RMA_Win_);
+
+    MPI_Group world_group;
+
+    MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+    MPI_Group_incl(world_group, static_cast<int>(sources.size()), Data(sources),
+                   &RMA_Sources_Group_);
+    MPI_Group_incl(world_group, static_cast<int>(dests.size()), Data(dests),
+                   &RMA_Dests_Group_);
+    MPI_Group_free(&world_group);
 }
 
 /**
- * \brief Calculate iterations.
+ * \brief Pool of wire data (for peers exchange modes).
  *
- * \param[in] n - iterations number
+ * \return
+ * Pool pointer.
  */
-void Grid::Calculate_Iterations(int n)
+char *Grid::Wire_Pool() const
 {
-    for (int i = 0; i < n; i++)
+    return (Precision() == Precision::Double)
+           ? reinterpret_cast<char *>(Peers_Pool_p_)
+           : Wire_Pool_p_;
+}
+
+/**
+ * \brief MPI type of wire data.
+ *
+ * \return
+ * Doubles are sent as doubles, encoded data is sent as bytes.
+ */
+MPI_Datatype Grid::Wire_Type() const
+{
+    return (Precision() == Precision::Double) ? MPI_DOUBLE : MPI_BYTE;
+}
+
+/**
+ * \brief Count of wire data elements.
+ *
+ * \param[in] bytes - bytes count
+ *
+ * \return
+ * Count of elements of wire type.
+ */
+int Grid::Wire_Count(int bytes) const
+{
+    return (Precision() == Precision::Double) ? (bytes / (int)sizeof(double)) : bytes;
+}
+
+/**
+ * \brief Free persistent requests and buffers of MPI data exchange for interfaces.
+ */
+void Grid::Free_Ifaces_MPI_Data_Exchange()
+{
+    int finalized = 0;
+
+    MPI_Finalized(&finalized);
+
+    if (!finalized)
     {
-        cout << setw(3) << Lib::MPI::Rank() << " | iter: " << setw(5) << i;
-        Calculate_Iteration();
-        cout << " : done" << endl;
+        for (int i = 0; i < (int)Shadows_Requests_.size(); i++)
+        {
+            if (Shadows_Requests_[i] != MPI_REQUEST_NULL)
+            {
+                MPI_Request_free(&Shadows_Requests_[i]);
+            }
+        }
+
+        if (Neighbors_Comm_ != MPI_COMM_NULL)
+        {
+            MPI_Comm_free(&Neighbors_Comm_);
+        }
+
+        if (RMA_Win_ != MPI_WIN_NULL)
+        {
+            MPI_Win_free(&RMA_Win_);
+        }
+
+        if ((RMA_Sources_Group_ != MPI_GROUP_NULL) && (RMA_Sources_Group_ != MPI_GROUP_EMPTY))
+        {
+            MPI_Group_free(&RMA_Sources_Group_);
+        }
+
+        if ((RMA_Dests_Group_ != MPI_GROUP_NULL) && (RMA_Dests_Group_ != MPI_GROUP_EMPTY))
+        {
+            MPI_Group_free(&RMA_Dests_Group_);
+        }
+    }
+
+    Shadows_Requests_.clear();
+    Messages_.clear();
+    Ifaces_Buffers_.clear();
+    Recv_Ifaces_.clear();
+    Ifaces_Messages_.clear();
+    Ifaces_Unpacked_.clear();
+    Blocks_Waited_Ifaces_.clear();
+    Neighbors_Comm_ = MPI_COMM_NULL;
+    Neighbors_Send_Counts_.clear();
+    Neighbors_Send_Displs_.clear();
+    Neighbors_Recv_Counts_.clear();
+    Neighbors_Recv_Displs_.clear();
+    RMA_Win_ = MPI_WIN_NULL;
+    RMA_Sources_Group_ = MPI_GROUP_NULL;
+    RMA_Dests_Group_ = MPI_GROUP_NULL;
+
+    Ifaces_Wires_.clear();
+
+    if (Peers_Pool_p_ != NULL)
+    {
+        delete [] Peers_Pool_p_;
+        Peers_Pool_p_ = NULL;
+    }
+
+    if (Wire_Pool_p_ != NULL)
+    {
+        delete [] Wire_Pool_p_;
+        Wire_Pool_p_ = NULL;
     }
 }
 
 /**
- * \brief MPI data exchange for interfaces.
+ * \brief Start MPI data exchange for interfaces.
+ *
+ * Persistent requests are started or nonblocking neighborhood collective is called
+ * (by all ranks, even without neighbours) or data is put into MPI windows of peers
+ * (access epoch is completed here, exposure epoch is finished by test or wait).
+ * Exchange timer runs until delivery of all messages is seen.
  */
-void Grid::Ifaces_MPI_Data_Exchange()
+void Grid::Ifaces_MPI_Data_Exchange_Start()
 {
-    Timer_Shadow_Exchange()->Start();
+    int reqs_count = static_cast<int>(Shadows_Requests_.size());
 
-    MPI_Request reqs[1000];
-    MPI_Status stats[1000];
-    int reqs_count = 0;
-    int i = 0;
+    Shadows_Requests_Count_ = reqs_count;
+
+    Timer_Shadow_Exchange()->Start();
 
-    // Process all interfaces.
-    while (i < Ifaces_Count())
+    if (reqs_count == 0)
     {
-        Iface *p = Get_Iface(i);
+        Timer_Shadow_Exchange()->Stop();
+    }
+    else if (Exchange() == Exchange::Neighbors)
+    {
+        char *pool_p = Wire_Pool();
+
+        MPI_Ineighbor_alltoallv(pool_p,
+                                Data(Neighbors_Send_Counts_), Data(Neighbors_Send_Displs_),
+                                Wire_Type(),
+                                pool_p + Wire_Recv_Offset_,
+                                Data(Neighbors_Recv_Counts_), Data(Neighbors_Recv_Displs_),
+                                Wire_Type(),
+                                Neighbors_Comm_, &Shadows_Requests_[0]);
+    }
+    else if (Exchange() == Exchange::RMA)
+    {
+        // Our pool is exposed to sources, we access pools of destinations.
+        MPI_Win_post(RMA_Sources_Group_, 0, RMA_Win_);
+        MPI_Win_start(RMA_Dests_Group_, 0, RMA_Win_);
 
-        if (p->Is_BActive())
+        for (int m = 0; m < (int)Messages_.size(); m++)
         {
-            if (p->Is_NActive())
-            {
-                // Both blocks are active.
-                // We can replace data without MPI.
+            const Message &msg = Messages_[m];
 
-                i += 2;
-            }
-            else
+            if (msg.Is_Send)
             {
-                // Self block is active, neighbour is not.
-                // We have to receive data from neighbour block process.
+                int count = Wire_Count(msg.Wire_Bytes_Count);
 
-                MPI_Irecv(p->MPI_Buffer(), p->Buffer_Doubles_Count(), MPI_FLOAT,
-                          p->NB()->Rank(), p->Id(), MPI_COMM_WORLD, &reqs[reqs_count++]);
-                i++;
+                MPI_Put(msg.Wire_p, count, Wire_Type(),
+                        msg.Peer, msg.Target_Displ, count, Wire_Type(), RMA_Win_);
             }
         }
+
+        MPI_Win_complete(RMA_Win_);
+    }
+    else
+    {
+        MPI_Startall(reqs_count, &Shadows_Requests_[0]);
+    }
+}
+
+/**
+ * \brief Wait MPI data exchange for interfaces.
+ */
+void Grid::Ifaces_MPI_Data_Exchange_Wait()
+{
+    if (Shadows_Requests_Count_ > 0)
+    {
+        Timer_Shadow_Wait()->Start();
+        if (Exchange() == Exchange::RMA)
+        {
+            MPI_Win_wait(RMA_Win_);
+        }
         else
         {
-            if (p->Is_NActive())
-            {
-                // Neighbour block is active, self is not.
-                // We have to send data to self block process.
-                MPI_Isend(p->MPI_Buffer(), p->Buffer_Doubles_Count(), MPI_FLOAT,
-                          p->B()->Rank(), p->Id(), MPI_COMM_WORLD, &reqs[reqs_count++]);
-                i++;
-            }
-            else
-            {
-                // Self and neighbour blocks are not active.
-                // Nothing to do.
-                i += 2;
-            }
+            MPI_Waitall(Shadows_Requests_Count_, &Shadows_Requests_[0], MPI_STATUSES_IGNORE);
         }
-    }
+        Timer_Shadow_Wait()->Stop();
 
-    // Wait all requests.
-    MPI_Waitall(reqs_count, reqs, stats);
-
-    Timer_Shadow_Exchange()->Stop();
+        Shadows_Requests_Count_ = 0;
+        Timer_Shadow_Exchange()->Stop();
+    }
 }
 
 /*
@@ -760,12 +2970,164 @@ void Grid::Ifaces_MPI_Data_Exchange()
 /**
  * \brief Print timers.
  *
+ * Shadows exchange time is measured from posting of messages to seen delivery,
+ * wait time is its part spent in waiting, the rest is hidden by calculations.
+ *
  * \param[in] os - stream
  */
 void Grid::Print_Timers(ostream &os)
 {
     os << "Timers:" << endl;
     os << "  MPI_Shadow_Exchange : " << Timer_Shadow_Exchange()->Time() << endl;
+    os << "  MPI_Shadow_Wait     : " << Timer_Shadow_Wait()->Time() << endl;
+    os << "  MPI_Shadow_Hidden   : "
+       << (Timer_Shadow_Exchange()->Time() - Timer_Shadow_Wait()->Time()) << endl;
+    os << "  MPI_Time_Step       : " << Timer_Time_Step()->Time() << endl;
+    os << "  MPI_Migration       : " << Timer_Migration()->Time() << endl;
+}
+
+/**
+ * \brief Print rebalancing counters.
+ *
+ * \param[in] os - stream
+ */
+void Grid::Print_Rebalancing(ostream &os)
+{
+    os << "Rebalancing:" << endl;
+    os << "  Checks     : " << Rebalance_Checks_Count() << endl;
+    os << "  Migrations : " << Migrations_Count() << endl;
+    os << "  Blocks     : " << Migrated_Blocks_Count() << endl;
+    os << "  Bytes      : " << Migrated_Bytes_Count() << endl;
+    os << "  Time       : " << setprecision(6) << fixed << Timer_Migration()->Time() << endl;
+    os << "  Imbalance  : " << setprecision(2) << fixed << (Imbalance_Before() * 100.0)
+       << " % -> " << (Imbalance_After() * 100.0) << " %" << endl;
+}
+
+/**
+ * \brief Print interfaces exchange plan of this rank.
+ *
+ * \param[in] os - stream
+ */
+void Grid::Print_Exchange_Plan(ostream &os)
+{
+    int ifaces = 0;
+    int doubles = 0;
+    int max_doubles = 0;
+    long bytes = 0;
+
+    os << "Exchange plan (" << Exchange::Name(Exchange()) << ", "
+       << Precision::Name(Precision()) << ") of rank " << Lib::MPI::Rank() << ":" << endl;
+
+    for (int m = 0; m < (int)Messages_.size(); m++)
+    {
+        const Message &msg = Messages_[m];
+
+        if (Exchange() != Exchange::Ifaces)
+        {
+            os << "  " << (msg.Is_Send ? "send to   " : "recv from ") << setw(4) << msg.Peer
+               << " : ifaces " << setw(6) << msg.Ifaces_Count
+               << ", doubles " << setw(10) << msg.Doubles_Count
+               << ", bytes " << setw(10) << msg.Wire_Bytes_Count << endl;
+        }
+
+        ifaces += msg.Ifaces_Count;
+        doubles += msg.Doubles_Count;
+        max_doubles = max(max_doubles, msg.Doubles_Count);
+        bytes += msg.Wire_Bytes_Count;
+    }
+
+    if (Neighbors_Comm_ != MPI_COMM_NULL)
+    {
+        int graph_rank;
+
+        MPI_Comm_rank(Neighbors_Comm_, &graph_rank);
+        os << "  rank in neighbors graph " << graph_rank << endl;
+    }
+
+    if (Exchange() == Exchange::Shared)
+    {
+        int node_size;
+        int node_ifaces = 0;
+
+        MPI_Comm_size(Node_Comm_, &node_size);
+
+        for (int i = 0; i < Ifaces_Count(); i++)
+        {
+            Iface *p = Get_Iface(i);
+
+            if (Is_Direct_Iface(p) && !p->Is_NActive())
+            {
+                node_ifaces++;
+            }
+        }
+
+        os << "  ranks in node " << node_size << ", ifaces from node ranks " << node_ifaces << endl;
+    }
+
+    os << "  messages " << Messages_.size() << ", ifaces " << ifaces
+       << ", doubles " << doubles << ", max message " << max_doubles << " doubles"
+       << ", bytes " << bytes << endl;
+}
+
+/**
+ * \brief Print errors of interfaces transfer precision.
+ *
+ * All interfaces which can be packed on this rank are packed from current layer,
+ * encoded and decoded, maximum absolute error of each variable is compared
+ * with maximum absolute value of variable.
+ *
+ * \param[in] os - stream
+ */
+void Grid::Print_Precision_Errors(ostream &os)
+{
+    const string names[6] = { "R", "VX", "VY", "VZ", "E", "P" };
+    double errs[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    double norms[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    int depth = Shadow::Depth();
+
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        Iface *p = Get_Iface(i);
+
+        if (!p->Is_NActive())
+        {
+            continue;
+        }
+
+        int stride = p->Buffer_Cells_Count();
+        int n = depth * p->Cells_Count();
+        int wire_bytes = Precision::Bytes_Count(Precision(), Precision_Keep(), stride);
+        vector<double> buf(p->Buffer_Doubles_Count());
+        vector<double> res(p->Buffer_Doubles_Count());
+        vector<double> wire(wire_bytes / sizeof(double));
+
+        p->Pack(Layer(), depth, &buf[0]);
+        Precision::Encode(Precision(), Precision_Keep(), p->Buffer(&buf[0]), n, stride,
+                          reinterpret_cast<char *>(&wire[0]));
+        Precision::Decode(Precision(), Precision_Keep(), reinterpret_cast<char *>(&wire[0]),
+                          n, stride, p->Buffer(&res[0]));
+
+        for (int v = 0; v < 6; v++)
+        {
+            for (int c = v * stride; c < v * stride + n; c++)
+            {
+                errs[v] = max(errs[v], fabs(buf[c] - res[c]));
+                norms[v] = max(norms[v], fabs(buf[c]));
+            }
+        }
+    }
+
+    os << "Precision errors (" << Precision::Name(Precision()) << ", keep mask "
+       << Precision_Keep() << ") of rank " << Lib::MPI::Rank() << ":" << endl;
+
+    for (int v = 0; v < 6; v++)
+    {
+        os << "  " << setw(2) << names[v] << " : max error " << scientific << setprecision(3)
+           << errs[v] << ", relative " << ((norms[v] > 0.0) ? (errs[v] / norms[v]) : 0.0)
+           << endl;
+    }
+
+    os << fixed;
 }
 
 /**
@@ -781,6 +3143,7 @@ void Grid::Print_Statistics(ostream &os)
     int icc = Inner_Cells_Count();
     int bcc = Border_Cells_Count();
     int mcc = MPI_Cells_Count();
+    int imcc = Inter_Node_MPI_Cells_Count();
 
     os << "Statistics:" << endl;
 
@@ -792,6 +3155,7 @@ void Grid::Print_Statistics(ostream &os)
     os << "  Ifaces Count         : " << setw(8) << Ifaces_Count() << endl;
     os << "  Cells Count          : " << setw(8) << cc << endl;
     os << "  MBytes Count         : " << setw(8) << Bytes_Count() / (1024 * 1024) << endl;
+    os << "  Storage              : " << setw(8) << Storage::Name(Storage()) << endl;
     os << "  Inner Cells Count    : " << setw(8) << icc << endl;
     os << "  Inner Cells Percent  : " << setw(8) << setprecision(2) << fixed
                                       << (100.0 * icc / cc) << " %" << endl;
@@ -807,6 +3171,22 @@ void Grid::Print_Statistics(ostream &os)
     os << "     MPI Cells Count   : " << setw(8) << mcc << endl;
     os << "     MPI Cells Percent : " << setw(8) << setprecision(2) << fixed
                                       << (100.0 * mcc / cc) << " %" << endl;
+    os << "  Inter-node MPI Cells : " << setw(8) << imcc << endl;
+    os << "  Intra-node MPI Cells : " << setw(8) << (mcc - imcc) << endl;
+
+    /*
+     * Time steps.
+     */
+
+    os << "  Time Steps Count     : " << setw(8) << Steps_Count() << endl;
+    if (Steps_Count() > 0)
+    {
+        os << "  Time                 : " << scientific << setprecision(6) << Time() << endl;
+        os << "  Time Step Min        : " << Min_Dt() << endl;
+        os << "  Time Step Avg        : " << (Time() / Steps_Count()) << endl;
+        os << "  Time Step Max        : " << Max_Dt() << endl;
+        os << fixed;
+    }
 }
 
 /**
@@ -1040,9 +3420,101 @@ void Grid::Print_Blocks_Distribution(ostream &os, int ranks)
     m[ranks + 3].Print(os);
     os << "*----------*----------*----------*----------*----------*----------*----------*----------*----------*----------*----------*" << endl;
 
+    Print_Partition_Quality(os, ranks);
+
     // Free memory.
     delete m;
 }
 
+/**
+ * \brief Print quality of blocks partition between ranks.
+ *
+ * Edge cut of blocks graph is count of MPI cells (split into inter-node and intra-node),
+ * imbalance is excess of max cells count over mean. Messages of rank are sent and received messages of peers exchange,
+ * halo bytes of rank are sent and received bytes of one full depth shadows exchange
+ * in double precision.
+ *
+ * \param[in] os - stream
+ * \param[in] ranks - count of ranks
+ */
+void Grid::Print_Partition_Quality(ostream &os, int ranks)
+{
+    vector<long> cells(ranks, 0);
+    vector<long> halo_bytes(ranks, 0);
+    vector<int> messages(ranks, 0);
+    vector<vector<bool> > is_peers(ranks, vector<bool>(ranks, false));
+    long total_cells = 0;
+    long edge_cut = 0;
+    long inter_node_cut = 0;
+
+    for (int i = 0; i < Blocks_Count(); i++)
+    {
+        Block *p = Get_Block(i);
+
+        cells[p->Rank()] += p->Cells_Count();
+        total_cells += p->Cells_Count();
+    }
+
+    // Interface is received by rank of self block and sent by rank of neighbour block.
+    for (int i = 0; i < Ifaces_Count(); i++)
+    {
+        Iface *p = Get_Iface(i);
+        int r = p->B()->Rank();
+        int s = p->NB()->Rank();
+        long cc = p->Cells_Count() * HYDRO_GRID_SHADOW_DEPTH;
+
+        if (r == s)
+        {
+            continue;
+        }
+
+        edge_cut += cc;
+
+        if (Rank_Node(r) != Rank_Node(s))
+        {
+            inter_node_cut += cc;
+        }
+
+        halo_bytes[r] += cc * HYDRO_GRID_DYNAMIC_DOUBLES_PER_CELL * sizeof(double);
+        halo_bytes[s] += cc * HYDRO_GRID_DYNAMIC_DOUBLES_PER_CELL * sizeof(double);
+
+        if (!is_peers[r][s])
+        {
+            is_peers[r][s] = true;
+            messages[r]++;
+            messages[s]++;
+        }
+    }
+
+    long max_cells = *max_element(cells.begin(), cells.end());
+    long max_halo_bytes = *max_element(halo_bytes.begin(), halo_bytes.end());
+    int max_messages = *max_element(messages.begin(), messages.end());
+    long total_halo_bytes = 0;
+    long total_messages = 0;
+
+    for (int i = 0; i < ranks; i++)
+    {
+        total_halo_bytes += halo_bytes[i];
+        total_messages += messages[i];
+    }
+
+    double imbalance = (total_cells != 0)
+                       ? (100.0 * max_cells * ranks / total_cells - 100.0)
+                       : 0.0;
+
+    os << "  Balancing  : " << Balancing::Name(Balancing()) << endl;
+    os << "  Edge Cut   : " << edge_cut << endl;
+    os << "  Node Cut   : " << inter_node_cut << " inter-node, "
+       << (edge_cut - inter_node_cut) << " intra-node ("
+       << setprecision(2) << fixed
+       << ((edge_cut != 0) ? (100.0 * inter_node_cut / edge_cut) : 0.0)
+       << " % of halo volume over network)" << endl;
+    os << "  Imbalance  : " << setprecision(2) << fixed << imbalance << " %" << endl;
+    os << "  Messages   : max " << max_messages << ", mean "
+       << (static_cast<double>(total_messages) / ranks) << " (per rank)" << endl;
+    os << "  Halo Bytes : max " << max_halo_bytes << ", mean "
+       << (static_cast<double>(total_halo_bytes) / ranks) << " (per rank)" << endl;
+}
+
 } }
 
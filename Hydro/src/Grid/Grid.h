@@ -8,8 +8,12 @@
 #ifndef HYDRO_GRID_GRID_H
 #define HYDRO_GRID_GRID_H
 
+#include <vector>
 #include "Lib/MPI/mpi.h"
 #include "Iface.h"
+#include "Exchange.h"
+#include "Precision.h"
+#include "Balancing.h"
 
 namespace Hydro { namespace Grid {
 
@@ -42,9 +46,54 @@ public:
     int Inner_Cells_Count() const;
     int Border_Cells_Count() const;
     int MPI_Cells_Count() const;
+    int Inter_Node_MPI_Cells_Count() const;
+
+    // Cells storage mode (has to be set before grid creation).
+    int Storage() const { return Storage_; }
+    void Set_Storage(int storage) { assert(Is_Empty()); Storage_ = storage; }
+
+    // Blocks ranks balancing mode and tolerance of cells imbalance
+    // (have to be set before grid creation).
+    int Balancing() const { return Balancing_; }
+    double Balancing_Imbalance() const { return Balancing_Imbalance_; }
+    void Set_Balancing(int balancing,
+                       double imbalance = 0.05);
+
+    // Count of ranks per node (0 if nodes are found by shared memory communicator,
+    // has to be set before grid creation) and node of rank.
+    int Ranks_Per_Node() const { return Ranks_Per_Node_; }
+    void Set_Ranks_Per_Node(int ranks_per_node);
+    int Rank_Node(int rank) const;
+
+    // Blocks splitting (count of blocks per rank which blocks are split for,
+    // 0 if splitting is off, has to be set before grid creation).
+    int Blocks_Splitting() const { return Blocks_Splitting_; }
+    void Set_Blocks_Splitting(int blocks_per_rank);
+
+    // Planning mode: grid keeps only layout of blocks and interfaces without cells memory
+    // and exchange plan (for offline partitioning, has to be set before grid creation).
+    bool Is_Planning() const { return Is_Planning_; }
+    void Set_Planning(bool is_planning) { assert(Is_Empty()); Is_Planning_ = is_planning; }
+
+    // Partition file which blocks ranks are loaded from instead of balancing
+    // (empty name if there is no file, has to be set before grid creation).
+    const string &Partition_Name() const { return Partition_Name_; }
+    void Set_Partition(const string name) { assert(Is_Empty()); Partition_Name_ = name; }
+
+    // Interfaces exchange mode (message for each interface or for each peer rank).
+    int Exchange() const { return Exchange_; }
+    void Set_Exchange(int exchange);
+
+    // Precision of interfaces transfer (variables from keep mask are sent as doubles).
+    int Precision() const { return Precision_; }
+    int Precision_Keep() const { return Precision_Keep_; }
+    void Set_Precision(int precision,
+                       int keep);
 
     // Load and create Grid.
     bool Load_GEOM(const string name, int ranks_count);
+    bool Save_Partition(const string name,
+                        int ranks_count) const;
     void Create_Solid_Descartes(int i_size,
                                 int j_size,
                                 int k_size,
@@ -55,13 +104,49 @@ public:
     // Blocks ranks balancing.
     void Set_Blocks_Ranks_Circular_Distribution(int ranks_count);
     void Set_Blocks_Ranks_Cells_Balancing(int ranks_count);
+    void Set_Blocks_Ranks_Graph_Partitioning(int ranks_count,
+                                             double imbalance);
+    void Set_Blocks_Ranks_Nodes_Partitioning(int ranks_count,
+                                             double imbalance);
+
+    // Dynamic rebalancing (calculation times of blocks are accumulated by solver)
+    // and migration of blocks to new ranks (collective).
+    bool Rebalance(double threshold);
+    void Migrate_Blocks(const vector<int> &ranks);
+    void Reset_Blocks_Calc_Times();
+
+    // Rebalancing counters (imbalances of calculation times are for the last check).
+    int Rebalance_Checks_Count() const { return Rebalance_Checks_Count_; }
+    int Migrations_Count() const { return Migrations_Count_; }
+    int Migrated_Blocks_Count() const { return Migrated_Blocks_Count_; }
+    long Migrated_Bytes_Count() const { return Migrated_Bytes_Count_; }
+    double Imbalance_Before() const { return Imbalance_Before_; }
+    double Imbalance_After() const { return Imbalance_After_; }
 
     // Calculations.
     void Calculate_Iteration();
     void Calculate_Iterations(int n);
 
+    // Shadow layers of blocks (from neighbour blocks or reflected cells).
+    void Exchange_Shadows(int depth = Shadow::Depth());
+    void Start_Exchange_Shadows(int depth = Shadow::Depth());
+    bool Test_Exchange_Shadows();
+    bool Progress_Exchange_Shadows();
+    bool Is_Block_Shadows_Ready(int bi) const;
+    void Finish_Exchange_Shadows();
+
     // Timers.
     Lib::MPI::Timer *Timer_Shadow_Exchange() const { return Timer_Shadow_Exchange_p_; }
+    Lib::MPI::Timer *Timer_Shadow_Wait() const { return Timer_Shadow_Wait_p_; }
+    Lib::MPI::Timer *Timer_Time_Step() const { return Timer_Time_Step_p_; }
+    Lib::MPI::Timer *Timer_Migration() const { return Timer_Migration_p_; }
+
+    // Physical time and time steps statistics.
+    double Time() const { return Time_; }
+    int Steps_Count() const { return Steps_Count_; }
+    double Min_Dt() const { return Min_Dt_; }
+    double Max_Dt() const { return Max_Dt_; }
+    void Register_Time_Step(double dt);
 
     // Information.
     void Print_Timers(ostream &os);
@@ -69,6 +154,13 @@ public:
     void Print_Statistics(ostream &os);
     void Print_Statistics() { Print_Statistics(cout); }
     void Print_Blocks_Distribution(ostream &os, int ranks);
+    void Print_Partition_Quality(ostream &os, int ranks);
+    void Print_Exchange_Plan(ostream &os);
+    void Print_Exchange_Plan() { Print_Exchange_Plan(cout); }
+    void Print_Precision_Errors(ostream &os);
+    void Print_Precision_Errors() { Print_Precision_Errors(cout); }
+    void Print_Rebalancing(ostream &os);
+    void Print_Rebalancing() { Print_Rebalancing(cout); }
 
     // Layer manipuolations.
     int Layer() { return Layer_; }
@@ -76,6 +168,117 @@ public:
 
 private:
 
+    /**
+     * \brief Message of interfaces exchange (data of one or several interfaces).
+     */
+    class Message
+    {
+        public:
+
+            // Constructor.
+            Message(int peer,
+                    bool is_send,
+                    int tag)
+                : Peer(peer),
+                  Is_Send(is_send),
+                  Tag(tag),
+                  Ifaces_Count(0),
+                  Doubles_Count(0),
+                  Buffer_p(NULL),
+                  Wire_Bytes_Count(0),
+                  Wire_p(NULL),
+                  Target_Displ(0)
+            {
+            }
+
+            // Peer rank, direction and tag.
+            int Peer;
+            bool Is_Send;
+            int Tag;
+
+            // Size.
+            int Ifaces_Count;
+            int Doubles_Count;
+
+            // Data.
+            double *Buffer_p;
+
+            // Wire data (encoded data or the same as data for double precision).
+            int Wire_Bytes_Count;
+            char *Wire_p;
+
+            // Displacement of data in MPI window of peer (for sent messages of RMA exchange).
+            int Target_Displ;
+    };
+
+    /**
+     * \brief Block record of GEOM grid (sizes in cells).
+     */
+    class Block_Record
+    {
+        public:
+
+            // Constructor.
+            Block_Record(int i_size,
+                         int j_size,
+                         int k_size)
+            {
+                Sizes[0] = i_size;
+                Sizes[1] = j_size;
+                Sizes[2] = k_size;
+            }
+
+            // Count of cells.
+            int Cells_Count() const { return Sizes[0] * Sizes[1] * Sizes[2]; }
+
+            // Sizes (I, J, K).
+            int Sizes[3];
+    };
+
+    /**
+     * \brief Interface record of GEOM grid (area of nodes in self block coordinates).
+     */
+    class Iface_Record
+    {
+        public:
+
+            // Constructor.
+            Iface_Record()
+                : Id(0),
+                  B(0),
+                  NB(0)
+            {
+                for (int d = 0; d < 3; d++)
+                {
+                    Lo[d] = 0;
+                    Hi[d] = 0;
+                }
+            }
+
+            // Normal axis (first axis with one node, -1 if there is no such axis).
+            int Axis() const
+            {
+                for (int d = 0; d < 3; d++)
+                {
+                    if (Lo[d] == Hi[d])
+                    {
+                        return d;
+                    }
+                }
+
+                return -1;
+            }
+
+            // Identifier, self and neighbour blocks numbers.
+            int Id;
+            int B;
+            int NB;
+
+            // First and last nodes (I, J, K).
+            int Lo[3];
+            int Hi[3];
+    };
+
     // Count of blocks.
     int Blocks_Count_;
 
@@ -90,10 +293,104 @@ private:
 
     // Timers.
     Lib::MPI::Timer *Timer_Shadow_Exchange_p_;
+    Lib::MPI::Timer *Timer_Shadow_Wait_p_;
+    Lib::MPI::Timer *Timer_Time_Step_p_;
+    Lib::MPI::Timer *Timer_Migration_p_;
+
+    // Shadows exchange in progress (depth is 0 if there is no exchange).
+    int Shadows_Depth_;
+
+    // Interfaces exchange mode.
+    int Exchange_;
+
+    // Precision of interfaces transfer and variables kept in double precision.
+    int Precision_;
+    int Precision_Keep_;
+
+    // Interfaces exchange plan: buffers of interfaces (NULL if there is no MPI data),
+    // pool of buffers for peers exchange, wire data and offset of received data in its pool
+    // (sent data goes first), messages, requests (persistent requests of messages,
+    // request of neighborhood collective or RMA epoch marker) and count of them in progress.
+    vector<double *> Ifaces_Buffers_;
+    double *Peers_Pool_p_;
+    vector<char *> Ifaces_Wires_;
+    char *Wire_Pool_p_;
+    int Wire_Recv_Offset_;
+    vector<Message> Messages_;
+
+    // Neighborhood collective exchange: graph communicator,
+    // counts and displacements of sent and received wire data for neighbour ranks.
+    MPI_Comm Neighbors_Comm_;
+    vector<int> Neighbors_Send_Counts_;
+    vector<int> Neighbors_Send_Displs_;
+    vector<int> Neighbors_Recv_Counts_;
+    vector<int> Neighbors_Recv_Displs_;
+
+    // RMA exchange: window over received data and groups of ranks we receive from
+    // (exposure epoch) and send to (access epoch).
+    MPI_Win RMA_Win_;
+    MPI_Group RMA_Sources_Group_;
+    MPI_Group RMA_Dests_Group_;
+
+    // Shared memory exchange: communicator of node, window of cells of node blocks
+    // and flags of ranks of node.
+    MPI_Comm Node_Comm_;
+    MPI_Win Shared_Win_;
+    vector<bool> Node_Ranks_;
+
+    vector<MPI_Request> Shadows_Requests_;
+    int Shadows_Requests_Count_;
+
+    // Received interfaces and their messages, unpacked flags of interfaces
+    // and counts of not unpacked interfaces of blocks (for exchange progress).
+    vector<int> Recv_Ifaces_;
+    vector<int> Ifaces_Messages_;
+    vector<int> Ifaces_Unpacked_;
+    vector<int> Blocks_Waited_Ifaces_;
+    vector<int> Progress_Indices_;
+
+    // Interfaces between blocks of this rank and first rows of them (for direct copy).
+    vector<Iface *> Local_Ifaces_;
+    vector<int> Local_Ifaces_Rows_;
+
+    // Physical time and time steps statistics.
+    double Time_;
+    int Steps_Count_;
+    double Min_Dt_;
+    double Max_Dt_;
 
     // Active layer.
     int Layer_;
 
+    // Cells storage mode.
+    int Storage_;
+
+    // Blocks ranks balancing mode and tolerance of cells imbalance.
+    int Balancing_;
+    double Balancing_Imbalance_;
+
+    // Count of blocks per rank for blocks splitting (0 - no splitting).
+    int Blocks_Splitting_;
+
+    // Count of ranks per node (0 - nodes are found by MPI) and nodes of ranks.
+    int Ranks_Per_Node_;
+    vector<int> Ranks_Nodes_;
+
+    // Planning mode.
+    bool Is_Planning_;
+
+    // Name of partition file.
+    string Partition_Name_;
+
+    // Rebalancing counters: checks, migrations, migrated blocks and bytes,
+    // imbalances of calculation times before and after the last check.
+    int Rebalance_Checks_Count_;
+    int Migrations_Count_;
+    int Migrated_Blocks_Count_;
+    long Migrated_Bytes_Count_;
+    double Imbalance_Before_;
+    double Imbalance_After_;
+
     // Init.
     void Init_Timers();
 
@@ -106,11 +403,59 @@ private:
     void Deallocate_Ifaces_Pointers();
 
     // Load functions.
-    bool Load_GEOM_Ifaces(ifstream &s);
+    bool Load_GEOM_Ifaces(ifstream &s,
+                          vector<Iface_Record> &ifaces);
+    static bool Check_GEOM_Ifaces(const vector<Block_Record> &blocks,
+                                  const vector<Iface_Record> &ifaces);
+    static bool Is_Ifaces_Pair_Aligned(const vector<Iface_Record> &ifaces,
+                                       int i);
+    void Split_Blocks(vector<Block_Record> &blocks,
+                      vector<Iface_Record> &ifaces,
+                      int ranks_count) const;
+    static void Split_Block(vector<Block_Record> &blocks,
+                            vector<Iface_Record> &ifaces,
+                            int b,
+                            int x,
+                            int c,
+                            int &next_id);
+    bool Load_Partition(const string name,
+                        int ranks_count);
+    void Init_Ranks_Nodes(int ranks_count);
+    void Create_Ifaces(const vector<Iface_Record> &ifaces);
     void Set_Ifaces_To_Facets();
+    void Set_Ifaces_Pairs();
+
+    // Rebalancing functions.
+    void Gather_Blocks_Calc_Times(vector<double> &times) const;
+    static double Calc_Times_Imbalance(const vector<double> &times,
+                                       const vector<int> &ranks,
+                                       int ranks_count);
+    static void Plan_Rebalancing(const vector<double> &times,
+                                 int ranks_count,
+                                 vector<int> &ranks);
 
     // Some help functions for iteration.
-    void Ifaces_MPI_Data_Exchange();
+    bool Is_Node_Rank(int rank) const;
+    bool Is_Direct_Iface(const Iface *p) const;
+    bool Is_Send_Iface(const Iface *p) const;
+    bool Is_Recv_Iface(const Iface *p) const;
+    void Init_Shared_Memory();
+    void Free_Shared_Memory();
+    void Sync_Node();
+    void Unpack_Iface(int i);
+    void Init_Ifaces_MPI_Data_Exchange();
+    int Place_Messages(const vector<int> &msgs,
+                       const vector<int> &sizes,
+                       vector<int> &msgs_offsets,
+                       vector<int> &ifaces_offsets) const;
+    void Init_Neighbors_Comm();
+    void Init_RMA_Window();
+    char *Wire_Pool() const;
+    MPI_Datatype Wire_Type() const;
+    int Wire_Count(int bytes) const;
+    void Free_Ifaces_MPI_Data_Exchange();
+    void Ifaces_MPI_Data_Exchange_Start();
+    void Ifaces_MPI_Data_Exchange_Wait();
 };
 
 // Print information.
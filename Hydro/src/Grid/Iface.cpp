@@ -48,6 +48,7 @@ Iface::Iface(int id,
       K0_(k0),
       K1_(k1),
       NB_p_(nb_p),
+      Pair_p_(NULL),
       Direction_(-1),
       Buffer_p_(NULL)
 {
@@ -134,6 +135,21 @@ void Iface::Deallocate_Buffer()
     }
 }
 
+/**
+ * \brief Update buffer after change of blocks ranks (buffer is kept only for active interface).
+ */
+void Iface::Update_Buffer()
+{
+    if (!Is_Active())
+    {
+        Deallocate_Buffer();
+    }
+    else if (Buffer_p_ == NULL)
+    {
+        Allocate_Buffer();
+    }
+}
+
 /*
  * Simple data and characteristics.
  */
@@ -198,6 +214,202 @@ int Iface::Buffer_Cells_Count() const
     }
 }
 
+/**
+ * \brief Buffer in structure of arrays form.
+ *
+ * Buffer keeps shadow layers of self block from this interface:
+ * layer after layer, cells of layer are ordered by tangent indices
+ * of self block direction (see Shadow).
+ *
+ * \return
+ * Buffer arrays.
+ */
+Fluid_Dyn_Arrays Iface::Buffer() const
+{
+    return Buffer(Buffer_p_);
+}
+
+/**
+ * \brief Arrays of buffer placed in given memory.
+ *
+ * Memory has to be of Buffer_Doubles_Count size.
+ *
+ * \param[in] p - memory pointer
+ *
+ * \return
+ * Arrays.
+ */
+Fluid_Dyn_Arrays Iface::Buffer(double *p) const
+{
+    Fluid_Dyn_Arrays a;
+
+    a.Set_Memory(p, Buffer_Cells_Count());
+
+    return a;
+}
+
+/**
+ * \brief Tangent ranges of interface (in cells of self block).
+ *
+ * \param[out] a0 - first cell in a direction
+ * \param[out] a1 - end cell in a direction
+ * \param[out] b0 - first cell in b direction
+ * \param[out] b1 - end cell in b direction
+ */
+void Iface::Tangents(int &a0,
+                     int &a1,
+                     int &b0,
+                     int &b1) const
+{
+    Shadow::Tangents(Direction(), I0(), J0(), K0(), a0, b0);
+    Shadow::Tangents(Direction(), I1(), J1(), K1(), a1, b1);
+}
+
+/*
+ * Shadow data.
+ */
+
+/**
+ * \brief Get first cell of shadow row in neighbour block.
+ *
+ * Pair interface gives the same area in neighbour block coordinates.
+ * Tangent directions of both blocks are supposed to be matched in order
+ * (blocks coordinate systems are aligned, it is checked on grid loading).
+ *
+ * \param[in] l - shadow layer
+ * \param[in] b - row number (second tangent from the area beginning)
+ *
+ * \return
+ * Index of cell in neighbour block.
+ */
+int Iface::Pair_Row_Cell(int l,
+                         int b) const
+{
+    const Iface *q = Pair();
+
+    assert(q != NULL);
+
+    Block *nb_p = NB();
+    int d = q->Direction();
+    int sizes[3] = { nb_p->I_Size(), nb_p->J_Size(), nb_p->K_Size() };
+    int ns = sizes[d / 2];
+    int ln = (l < ns) ? l : (ns - 1);
+    int n = Direction::Is_Negative(d) ? ln : (ns - 1 - ln);
+    int na0, na1, nb0, nb1, i, j, k;
+
+    q->Tangents(na0, na1, nb0, nb1);
+    Shadow::Cell(d, n, na0, nb0 + b, i, j, k);
+
+    return nb_p->Cell_Index(i, j, k);
+}
+
+/**
+ * \brief Pack cells of neighbour block into buffer.
+ *
+ * Rows of J and K facets are copied by arrays.
+ *
+ * \param[in] layer - layer of cells data
+ * \param[in] depth - count of shadow layers
+ * \param[in] buf_p - buffer memory (own buffer or part of common pool)
+ */
+void Iface::Pack(int layer,
+                 int depth,
+                 double *buf_p)
+{
+    Block *nb_p = NB();
+    int stride = Shadow::A_Stride(Pair()->Direction(), nb_p->I_Size());
+    int a0, a1, b0, b1;
+
+    Tangents(a0, a1, b0, b1);
+
+    int as = a1 - a0;
+    int bs = b1 - b0;
+    Fluid_Dyn_Arrays buf = Buffer(buf_p);
+
+    for (int l = 0; l < depth; l++)
+    {
+        for (int b = 0; b < bs; b++)
+        {
+            nb_p->Get_Row(Pair_Row_Cell(l, b), stride, as, layer,
+                          buf.Shift((l * bs + b) * as));
+        }
+    }
+}
+
+/**
+ * \brief Shadow rows count.
+ *
+ * \param[in] depth - count of shadow layers
+ *
+ * \return
+ * Count of rows.
+ */
+int Iface::Rows_Count(int depth) const
+{
+    int a0, a1, b0, b1;
+
+    Tangents(a0, a1, b0, b1);
+
+    return depth * (b1 - b0);
+}
+
+/**
+ * \brief Copy row of neighbour block cells directly into shadow layer of self block.
+ *
+ * Used for interfaces between blocks of the same rank instead of Pack/Unpack,
+ * rows are independent, so they may be copied in parallel.
+ *
+ * \param[in] layer - layer of cells data
+ * \param[in] row - row number (layer * rows_in_layer + row_in_layer)
+ */
+void Iface::Copy_Row(int layer,
+                     int row)
+{
+    Block *nb_p = NB();
+    Shadow *sh_p = B()->Shadows;
+    int d = Direction();
+    int a0, a1, b0, b1;
+
+    Tangents(a0, a1, b0, b1);
+
+    int bs = b1 - b0;
+    int l = row / bs;
+    int b = row % bs;
+
+    nb_p->Get_Row(Pair_Row_Cell(l, b), Shadow::A_Stride(Pair()->Direction(), nb_p->I_Size()),
+                  a1 - a0, layer, sh_p->U[d].Shift(sh_p->Index(d, l, a0, b0 + b)));
+}
+
+/**
+ * \brief Unpack buffer into shadow layers of self block.
+ *
+ * \param[in] depth - count of shadow layers
+ * \param[in] buf_p - buffer memory (own buffer or part of common pool)
+ */
+void Iface::Unpack(int depth,
+                   double *buf_p)
+{
+    Shadow *sh_p = B()->Shadows;
+    int d = Direction();
+    int a0, a1, b0, b1;
+
+    Tangents(a0, a1, b0, b1);
+
+    int as = a1 - a0;
+    int bs = b1 - b0;
+    const Fluid_Dyn_Arrays buf = Buffer(buf_p);
+
+    for (int l = 0; l < depth; l++)
+    {
+        for (int b = 0; b < bs; b++)
+        {
+            Fluid_Dyn_Arrays s = sh_p->U[d].Shift(sh_p->Index(d, l, a0, b0 + b));
+
+            s.Copy(buf.Shift((l * bs + b) * as), as);
+        }
+    }
+}
+
 /*
  * Information.
  */
@@ -45,6 +45,8 @@ public:
     int K1() const { return K1_; }
     bool Is_BActive() const { return B()->Is_Active(); }
     Block *NB() const { return NB_p_; }
+    Iface *Pair() const { return Pair_p_; }
+    void Set_Pair(Iface *p) { Pair_p_ = p; }
     int Direction() const { return Direction_; }
     bool Is_NActive() const { return NB()->Is_Active(); }
     bool Is_Active() const { return Is_BActive() || Is_NActive(); }
@@ -55,6 +57,25 @@ public:
                                               * HYDRO_GRID_DYNAMIC_DOUBLES_PER_CELL; }
     int Buffer_Bytes_Count() const { return Buffer_Doubles_Count() * sizeof(double); }
     void *MPI_Buffer() { return static_cast<void *>(Buffer_p_); }
+    Fluid_Dyn_Arrays Buffer() const;
+    Fluid_Dyn_Arrays Buffer(double *p) const;
+    void Tangents(int &a0,
+                  int &a1,
+                  int &b0,
+                  int &b1) const;
+
+    // Buffer update (after change of blocks ranks).
+    void Update_Buffer();
+
+    // Shadow data.
+    void Pack(int layer,
+              int depth,
+              double *buf_p);
+    void Unpack(int depth,
+                double *buf_p);
+    int Rows_Count(int depth) const;
+    void Copy_Row(int layer,
+                  int row);
 
     // From parent.
     bool Is_Iface() const { return true; }
@@ -79,6 +100,9 @@ private:
     // Pointer to neighbour block.
     Block *NB_p_;
 
+    // Interface with the same identifier (from neighbour block to self one).
+    Iface *Pair_p_;
+
     // Direction to neighbour.
     int Direction_;
 
@@ -91,6 +115,8 @@ private:
 
     // Other.
     void Set_Direction();
+    int Pair_Row_Cell(int l,
+                      int b) const;
 };
 
 // Print information.
@@ -0,0 +1,733 @@
+/**
+ * \file
+ * \brief Multilevel graph partitioner functions realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include "Partitioner.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Count of vertices of coarsest graph per part.
+ */
+#define HYDRO_GRID_PARTITIONER_COARSEST_PER_PART 10
+
+/**
+ * \brief Maximum count of refinement passes.
+ */
+#define HYDRO_GRID_PARTITIONER_REFINE_PASSES 16
+
+/**
+ * \brief Order of vertices by weight (ascending, then by number).
+ */
+class Weight_Less
+{
+
+public:
+
+    // Constructor.
+    Weight_Less(const vector<int> &weights)
+        : Weights_(weights)
+    {
+    }
+
+    // Compare.
+    bool operator()(int a, int b) const
+    {
+        return (Weights_[a] < Weights_[b]) || ((Weights_[a] == Weights_[b]) && (a < b));
+    }
+
+private:
+
+    // Weights.
+    const vector<int> &Weights_;
+};
+
+/*
+ * Graph.
+ */
+
+/**
+ * \brief Sum of weights of cut edges.
+ *
+ * \param[in] parts - parts of vertices
+ *
+ * \return
+ * Edge cut.
+ */
+long Partitioner::Graph::Cut(const vector<int> &parts) const
+{
+    long cut = 0;
+
+    for (int v = 0; v < Count(); v++)
+    {
+        for (int e = Xadj[v]; e < Xadj[v + 1]; e++)
+        {
+            if ((Adj[e] > v) && (parts[Adj[e]] != parts[v]))
+            {
+                cut += Adj_Weights[e];
+            }
+        }
+    }
+
+    return cut;
+}
+
+/**
+ * \brief Weight of the heaviest part.
+ *
+ * \param[in] parts_count - count of parts
+ * \param[in] parts - parts of vertices
+ *
+ * \return
+ * Maximum weight of part.
+ */
+long Partitioner::Graph::Max_Part(int parts_count,
+                                  const vector<int> &parts) const
+{
+    vector<long> parts_weights(parts_count, 0);
+
+    for (int v = 0; v < Count(); v++)
+    {
+        parts_weights[parts[v]] += Weights[v];
+    }
+
+    return *max_element(parts_weights.begin(), parts_weights.end());
+}
+
+/*
+ * Constructors/destructors.
+ */
+
+/**
+ * \brief Constructor (graph without edges, all weights are 1).
+ *
+ * \param[in] vertices_count - count of vertices
+ */
+Partitioner::Partitioner(int vertices_count)
+    : Weights_(vertices_count, 1),
+      Edges_(vertices_count)
+{
+}
+
+/**
+ * \brief Default destructor.
+ */
+Partitioner::~Partitioner()
+{
+}
+
+/*
+ * Graph.
+ */
+
+/**
+ * \brief Set weight of vertex.
+ *
+ * \param[in] v - vertex
+ * \param[in] w - weight
+ */
+void Partitioner::Set_Vertex_Weight(int v,
+                                    int w)
+{
+    assert((v >= 0) && (v < Vertices_Count()) && (w >= 0));
+
+    Weights_[v] = w;
+}
+
+/**
+ * \brief Add edge (weights of edges between the same vertices are summed, loops are ignored).
+ *
+ * \param[in] a - first vertex
+ * \param[in] b - second vertex
+ * \param[in] w - weight
+ */
+void Partitioner::Add_Edge(int a,
+                           int b,
+                           int w)
+{
+    assert((a >= 0) && (a < Vertices_Count()) && (b >= 0) && (b < Vertices_Count()));
+
+    if (a == b)
+    {
+        return;
+    }
+
+    Edges_[a][b] += w;
+    Edges_[b][a] += w;
+}
+
+/*
+ * Partitioning.
+ */
+
+/**
+ * \brief Partition graph.
+ *
+ * Weight limit of part is average weight increased by tolerance
+ * (but not less than weight of the heaviest vertex).
+ * If no partition meets the limit, partition with the lightest heaviest part is taken.
+ *
+ * \param[in] parts_count - count of parts
+ * \param[in] imbalance - tolerance of parts weights imbalance (0.05 is 5 %)
+ * \param[out] parts - parts of vertices
+ */
+void Partitioner::Partition(int parts_count,
+                            double imbalance,
+                            vector<int> &parts) const
+{
+    assert(parts_count > 0);
+    assert(imbalance >= 0.0);
+
+    int n = Vertices_Count();
+
+    parts.assign(n, 0);
+
+    if ((n == 0) || (parts_count == 1))
+    {
+        return;
+    }
+
+    // Original graph.
+    vector<Graph> graphs(1);
+    vector< vector<int> > coarses;
+    long total = 0;
+    int max_weight = 0;
+
+    graphs[0].Weights = Weights_;
+    Set_Adjacency(graphs[0], Edges_);
+
+    for (int v = 0; v < n; v++)
+    {
+        total += Weights_[v];
+        max_weight = max(max_weight, Weights_[v]);
+    }
+
+    long limit = max(static_cast<long>(ceil((1.0 + imbalance) * total / parts_count)),
+                     static_cast<long>(max_weight));
+
+    // Coarsening (vertices are not merged into more than half of part).
+    long max_coarse_weight = max(static_cast<long>(max_weight), total / (2 * parts_count));
+
+    while (graphs.back().Count() > HYDRO_GRID_PARTITIONER_COARSEST_PER_PART * parts_count)
+    {
+        Graph cg;
+        vector<int> coarse;
+
+        Coarsen(graphs.back(), max_coarse_weight, coarse, cg);
+
+        if (cg.Count() > 0.95 * graphs.back().Count())
+        {
+            // Matching is exhausted.
+            break;
+        }
+
+        graphs.push_back(cg);
+        coarses.push_back(coarse);
+    }
+
+    // Partitioning of coarsest graph.
+    const Graph &cg = graphs.back();
+    vector<int> grown, greedy;
+
+    Grow(cg, parts_count, grown);
+    Refine(cg, parts_count, limit, grown);
+    Greedy_Weights(cg, parts_count, greedy);
+    Refine(cg, parts_count, limit, greedy);
+    parts = Is_Better(cg, parts_count, limit, grown, greedy) ? grown : greedy;
+
+    // Projection to finer levels.
+    for (int l = static_cast<int>(coarses.size()) - 1; l >= 0; l--)
+    {
+        vector<int> fine(graphs[l].Count());
+
+        for (int v = 0; v < graphs[l].Count(); v++)
+        {
+            fine[v] = parts[coarses[l][v]];
+        }
+
+        parts.swap(fine);
+        Refine(graphs[l], parts_count, limit, parts);
+    }
+
+    // Greedy weights balancing of original graph (as it is and refined)
+    // is kept if it is better.
+    Greedy_Weights(graphs[0], parts_count, greedy);
+
+    if (Is_Better(graphs[0], parts_count, limit, greedy, parts))
+    {
+        parts = greedy;
+    }
+
+    Refine(graphs[0], parts_count, limit, greedy);
+
+    if (Is_Better(graphs[0], parts_count, limit, greedy, parts))
+    {
+        parts.swap(greedy);
+    }
+}
+
+/*
+ * Partition quality.
+ */
+
+/**
+ * \brief Sum of weights of edges between different parts.
+ *
+ * \param[in] parts - parts of vertices
+ *
+ * \return
+ * Edge cut.
+ */
+long Partitioner::Edge_Cut(const vector<int> &parts) const
+{
+    long cut = 0;
+
+    for (int a = 0; a < Vertices_Count(); a++)
+    {
+        for (map<int, int>::const_iterator it = Edges_[a].begin(); it != Edges_[a].end(); ++it)
+        {
+            if ((it->first > a) && (parts[it->first] != parts[a]))
+            {
+                cut += it->second;
+            }
+        }
+    }
+
+    return cut;
+}
+
+/**
+ * \brief Imbalance of parts weights (excess of the heaviest part over average).
+ *
+ * \param[in] parts_count - count of parts
+ * \param[in] parts - parts of vertices
+ *
+ * \return
+ * Imbalance (0.0 for ideal balance).
+ */
+double Partitioner::Imbalance(int parts_count,
+                              const vector<int> &parts) const
+{
+    vector<long> parts_weights(parts_count, 0);
+    long total = 0;
+
+    for (int v = 0; v < Vertices_Count(); v++)
+    {
+        parts_weights[parts[v]] += Weights_[v];
+        total += Weights_[v];
+    }
+
+    if (total == 0)
+    {
+        return 0.0;
+    }
+
+    long max_part = *max_element(parts_weights.begin(), parts_weights.end());
+
+    return static_cast<double>(max_part) * parts_count / total - 1.0;
+}
+
+/*
+ * Levels.
+ */
+
+/**
+ * \brief Set adjacency of graph from edges of vertices.
+ *
+ * \param[in,out] g - graph
+ * \param[in] edges - edges of vertices
+ */
+void Partitioner::Set_Adjacency(Graph &g,
+                                const vector< map<int, int> > &edges)
+{
+    g.Xadj.assign(1, 0);
+    g.Adj.clear();
+    g.Adj_Weights.clear();
+
+    for (int v = 0; v < static_cast<int>(edges.size()); v++)
+    {
+        for (map<int, int>::const_iterator it = edges[v].begin(); it != edges[v].end(); ++it)
+        {
+            g.Adj.push_back(it->first);
+            g.Adj_Weights.push_back(it->second);
+        }
+
+        g.Xadj.push_back(static_cast<int>(g.Adj.size()));
+    }
+}
+
+/**
+ * \brief Coarsen graph by heavy edge matching.
+ *
+ * Vertices are visited from the lightest, each one is matched with not matched
+ * neighbour through the heaviest edge (if weight of pair does not exceed limit).
+ *
+ * \param[in] g - graph
+ * \param[in] max_weight - maximum weight of coarse vertex
+ * \param[out] coarse - coarse vertices of vertices
+ * \param[out] cg - coarse graph
+ */
+void Partitioner::Coarsen(const Graph &g,
+                          long max_weight,
+                          vector<int> &coarse,
+                          Graph &cg)
+{
+    int n = g.Count();
+    vector<int> order(n), match(n, -1);
+
+    for (int v = 0; v < n; v++)
+    {
+        order[v] = v;
+    }
+
+    sort(order.begin(), order.end(), Weight_Less(g.Weights));
+
+    for (int i = 0; i < n; i++)
+    {
+        int v = order[i];
+        int best = -1;
+
+        if (match[v] != -1)
+        {
+            continue;
+        }
+
+        for (int e = g.Xadj[v]; e < g.Xadj[v + 1]; e++)
+        {
+            int u = g.Adj[e];
+
+            if ((match[u] != -1)
+                || (static_cast<long>(g.Weights[v]) + g.Weights[u] > max_weight))
+            {
+                continue;
+            }
+
+            if ((best == -1)
+                || (g.Adj_Weights[e] > g.Adj_Weights[best])
+                || ((g.Adj_Weights[e] == g.Adj_Weights[best])
+                    && (g.Weights[u] < g.Weights[g.Adj[best]])))
+            {
+                best = e;
+            }
+        }
+
+        if (best == -1)
+        {
+            match[v] = v;
+        }
+        else
+        {
+            match[v] = g.Adj[best];
+            match[g.Adj[best]] = v;
+        }
+    }
+
+    // Numbers of coarse vertices.
+    int count = 0;
+
+    coarse.assign(n, -1);
+
+    for (int v = 0; v < n; v++)
+    {
+        if (coarse[v] == -1)
+        {
+            coarse[v] = count;
+            coarse[match[v]] = count;
+            count++;
+        }
+    }
+
+    // Coarse graph.
+    vector< map<int, int> > edges(count);
+
+    cg.Weights.assign(count, 0);
+
+    for (int v = 0; v < n; v++)
+    {
+        cg.Weights[coarse[v]] += g.Weights[v];
+
+        for (int e = g.Xadj[v]; e < g.Xadj[v + 1]; e++)
+        {
+            int cu = coarse[g.Adj[e]];
+
+            if (cu != coarse[v])
+            {
+                edges[coarse[v]][cu] += g.Adj_Weights[e];
+            }
+        }
+    }
+
+    Set_Adjacency(cg, edges);
+}
+
+/*
+ * Partitioning of level.
+ */
+
+/**
+ * \brief Greedy balancing of weights (the heaviest vertex goes to the lightest part).
+ *
+ * \param[in] g - graph
+ * \param[in] parts_count - count of parts
+ * \param[out] parts - parts of vertices
+ */
+void Partitioner::Greedy_Weights(const Graph &g,
+                                 int parts_count,
+                                 vector<int> &parts)
+{
+    int n = g.Count();
+    vector<int> order(n);
+    vector<long> parts_weights(parts_count, 0);
+
+    for (int v = 0; v < n; v++)
+    {
+        order[v] = v;
+    }
+
+    sort(order.begin(), order.end(), Weight_Less(g.Weights));
+    parts.assign(n, 0);
+
+    for (int i = n - 1; i >= 0; i--)
+    {
+        int v = order[i];
+        int p = static_cast<int>(min_element(parts_weights.begin(), parts_weights.end())
+                                 - parts_weights.begin());
+
+        parts[v] = p;
+        parts_weights[p] += g.Weights[v];
+    }
+}
+
+/**
+ * \brief Greedy graph growing.
+ *
+ * Parts are grown one by one from the heaviest free vertex, the most connected free
+ * vertex is added while part is lighter than average of remaining weight
+ * (the last part takes all remaining vertices).
+ *
+ * \param[in] g - graph
+ * \param[in] parts_count - count of parts
+ * \param[out] parts - parts of vertices
+ */
+void Partitioner::Grow(const Graph &g,
+                       int parts_count,
+                       vector<int> &parts)
+{
+    int n = g.Count();
+    int assigned = 0;
+    long left = 0;
+
+    for (int v = 0; v < n; v++)
+    {
+        left += g.Weights[v];
+    }
+
+    parts.assign(n, -1);
+
+    for (int p = 0; p < parts_count; p++)
+    {
+        bool is_last = (p == parts_count - 1);
+        long target = left / (parts_count - p);
+        long w = 0;
+        vector<long> conns(n, 0);
+
+        while ((assigned < n) && (is_last || (w < target)))
+        {
+            int best = -1;
+
+            for (int v = 0; v < n; v++)
+            {
+                if ((parts[v] == -1)
+                    && ((best == -1)
+                        || (conns[v] > conns[best])
+                        || ((conns[v] == conns[best]) && (g.Weights[v] > g.Weights[best]))))
+                {
+                    best = v;
+                }
+            }
+
+            // Stop if part is closer to target without this vertex.
+            if (!is_last && (w > 0) && (w + g.Weights[best] - target > target - w))
+            {
+                break;
+            }
+
+            parts[best] = p;
+            w += g.Weights[best];
+            assigned++;
+
+            for (int e = g.Xadj[best]; e < g.Xadj[best + 1]; e++)
+            {
+                conns[g.Adj[e]] += g.Adj_Weights[e];
+            }
+        }
+
+        left -= w;
+    }
+}
+
+/**
+ * \brief Refinement of partition by moves of vertices.
+ *
+ * Vertex is moved to neighbour part if it decreases edge cut, or keeps it and
+ * improves balance, or if its part exceeds weight limit
+ * (target part has to stay in weight limit).
+ *
+ * \param[in] g - graph
+ * \param[in] parts_count - count of parts
+ * \param[in] limit - weight limit of part
+ * \param[in,out] parts - parts of vertices
+ */
+void Partitioner::Refine(const Graph &g,
+                         int parts_count,
+                         long limit,
+                         vector<int> &parts)
+{
+    int n = g.Count();
+    vector<long> parts_weights(parts_count, 0);
+    vector<long> conns(parts_count, 0);
+    vector<bool> is_touched(parts_count, false);
+    vector<int> touched;
+
+    for (int v = 0; v < n; v++)
+    {
+        parts_weights[parts[v]] += g.Weights[v];
+    }
+
+    for (int pass = 0; pass < HYDRO_GRID_PARTITIONER_REFINE_PASSES; pass++)
+    {
+        bool is_moved = false;
+
+        for (int v = 0; v < n; v++)
+        {
+            int from = parts[v];
+            bool is_over = (parts_weights[from] > limit);
+
+            // Connections of vertex with parts.
+            touched.clear();
+
+            for (int e = g.Xadj[v]; e < g.Xadj[v + 1]; e++)
+            {
+                int t = parts[g.Adj[e]];
+
+                if (!is_touched[t])
+                {
+                    is_touched[t] = true;
+                    touched.push_back(t);
+                }
+
+                conns[t] += g.Adj_Weights[e];
+            }
+
+            if (is_over)
+            {
+                int t = static_cast<int>(min_element(parts_weights.begin(), parts_weights.end())
+                                         - parts_weights.begin());
+
+                if (!is_touched[t])
+                {
+                    is_touched[t] = true;
+                    touched.push_back(t);
+                }
+            }
+
+            // The best move.
+            int best = -1;
+            long best_gain = 0;
+
+            for (int i = 0; i < static_cast<int>(touched.size()); i++)
+            {
+                int t = touched[i];
+                long tw = parts_weights[t] + g.Weights[v];
+                long gain = conns[t] - conns[from];
+
+                if ((t == from) || (tw > limit))
+                {
+                    continue;
+                }
+
+                if ((gain > 0) || ((gain == 0) && (tw < parts_weights[from])) || is_over)
+                {
+                    if ((best == -1)
+                        || (gain > best_gain)
+                        || ((gain == best_gain) && (parts_weights[t] < parts_weights[best])))
+                    {
+                        best = t;
+                        best_gain = gain;
+                    }
+                }
+            }
+
+            for (int i = 0; i < static_cast<int>(touched.size()); i++)
+            {
+                conns[touched[i]] = 0;
+                is_touched[touched[i]] = false;
+            }
+
+            if (best != -1)
+            {
+                parts[v] = best;
+                parts_weights[from] -= g.Weights[v];
+                parts_weights[best] += g.Weights[v];
+                is_moved = true;
+            }
+        }
+
+        if (!is_moved)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * \brief Compare partitions.
+ *
+ * Partition meeting weight limit is better, of two such partitions
+ * the one with smaller edge cut is better, otherwise partition with lighter
+ * heaviest part (or with smaller edge cut for equal heaviest parts) is better.
+ *
+ * \param[in] g - graph
+ * \param[in] parts_count - count of parts
+ * \param[in] limit - weight limit of part
+ * \param[in] a - first partition
+ * \param[in] b - second partition
+ *
+ * \return
+ * true - if first partition is better than second,
+ * false - otherwise.
+ */
+bool Partitioner::Is_Better(const Graph &g,
+                            int parts_count,
+                            long limit,
+                            const vector<int> &a,
+                            const vector<int> &b)
+{
+    long max_a = g.Max_Part(parts_count, a);
+    long max_b = g.Max_Part(parts_count, b);
+    bool is_a = (max_a <= limit);
+    bool is_b = (max_b <= limit);
+
+    if (is_a != is_b)
+    {
+        return is_a;
+    }
+
+    long cut_a = g.Cut(a);
+    long cut_b = g.Cut(b);
+
+    if (!is_a)
+    {
+        return (max_a < max_b) || ((max_a == max_b) && (cut_a < cut_b));
+    }
+
+    return (cut_a < cut_b) || ((cut_a == cut_b) && (max_a < max_b));
+}
+
+} }
@@ -0,0 +1,115 @@
+/**
+ * \file
+ * \brief Multilevel graph partitioner.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_GRID_PARTITIONER_H
+#define HYDRO_GRID_PARTITIONER_H
+
+#include <vector>
+#include <map>
+#include "Lib/IO/io.h"
+
+using namespace std;
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Multilevel graph partitioner.
+ *
+ * Graph with weighted vertices and edges is split into given count of parts
+ * with minimal sum of weights of cut edges, weight of each part should not exceed
+ * average weight more than on given tolerance.
+ * Graph is coarsened by heavy edge matching, coarsest graph is partitioned
+ * by greedy graph growing and by greedy weights balancing (the best is taken),
+ * then partition is projected back and refined on each level by moves of vertices
+ * between parts (edge cut gain under weight limit).
+ * Partitioning is deterministic, so all ranks get the same result.
+ */
+class Partitioner
+{
+
+public:
+
+    // Constructors/destructors.
+    Partitioner(int vertices_count);
+    ~Partitioner();
+
+    // Graph.
+    int Vertices_Count() const { return static_cast<int>(Weights_.size()); }
+    void Set_Vertex_Weight(int v,
+                           int w);
+    void Add_Edge(int a,
+                  int b,
+                  int w);
+
+    // Partitioning.
+    void Partition(int parts_count,
+                   double imbalance,
+                   vector<int> &parts) const;
+
+    // Partition quality.
+    long Edge_Cut(const vector<int> &parts) const;
+    double Imbalance(int parts_count,
+                     const vector<int> &parts) const;
+
+private:
+
+    /**
+     * \brief Graph in compressed form (level of coarsening).
+     */
+    class Graph
+    {
+        public:
+
+            // Count of vertices.
+            int Count() const { return static_cast<int>(Weights.size()); }
+
+            // Partition quality.
+            long Cut(const vector<int> &parts) const;
+            long Max_Part(int parts_count,
+                          const vector<int> &parts) const;
+
+            // Vertices weights, offsets of adjacency lists of vertices,
+            // neighbours and edges weights.
+            vector<int> Weights;
+            vector<int> Xadj;
+            vector<int> Adj;
+            vector<int> Adj_Weights;
+    };
+
+    // Vertices weights and edges weights (for each vertex).
+    vector<int> Weights_;
+    vector< map<int, int> > Edges_;
+
+    // Levels.
+    static void Set_Adjacency(Graph &g,
+                              const vector< map<int, int> > &edges);
+    static void Coarsen(const Graph &g,
+                        long max_weight,
+                        vector<int> &coarse,
+                        Graph &cg);
+
+    // Partitioning of level.
+    static void Greedy_Weights(const Graph &g,
+                               int parts_count,
+                               vector<int> &parts);
+    static void Grow(const Graph &g,
+                     int parts_count,
+                     vector<int> &parts);
+    static void Refine(const Graph &g,
+                       int parts_count,
+                       long limit,
+                       vector<int> &parts);
+    static bool Is_Better(const Graph &g,
+                          int parts_count,
+                          long limit,
+                          const vector<int> &a,
+                          const vector<int> &b);
+};
+
+} }
+
+#endif
@@ -0,0 +1,238 @@
+/**
+ * \file
+ * \brief Precision of shadow data transfer functions realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include <cstring>
+#include "Precision.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Maximum of scaled 16-bit value.
+ */
+#define HYDRO_GRID_PRECISION_SCALED_MAX 65535.0
+
+/**
+ * \brief Variable array of arrays.
+ *
+ * \param[in] u - arrays
+ * \param[in] v - variable number (R, VX, VY, VZ, E, P)
+ *
+ * \return
+ * Variable array.
+ */
+static double *Var(const Fluid_Dyn_Arrays &u,
+                   int v)
+{
+    double *vars[6] = { u.R, u.VX, u.VY, u.VZ, u.E, u.P };
+
+    return vars[v];
+}
+
+/**
+ * \brief Name of precision mode.
+ *
+ * \param[in] precision - precision mode
+ *
+ * \return
+ * Name of precision mode.
+ */
+string Precision::Name(int precision)
+{
+    switch (precision)
+    {
+        case Double:
+            return "Double";
+
+        case Float:
+            return "Float";
+
+        case Scaled:
+            return "Scaled";
+
+        default:
+            assert(false);
+    }
+}
+
+/**
+ * \brief Bytes count of encoded variable part.
+ *
+ * \param[in] precision - precision mode
+ * \param[in] stride - count of values in part
+ *
+ * \return
+ * Bytes count (multiple of double size).
+ */
+int Precision::Var_Bytes_Count(int precision,
+                               int stride)
+{
+    int bytes;
+
+    switch (precision)
+    {
+        case Double:
+            bytes = stride * sizeof(double);
+            break;
+
+        case Float:
+            bytes = stride * sizeof(float);
+            break;
+
+        case Scaled:
+            bytes = 2 * sizeof(double) + stride * sizeof(unsigned short);
+            break;
+
+        default:
+            assert(false);
+            bytes = 0;
+    }
+
+    return (bytes + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+}
+
+/**
+ * \brief Bytes count of encoded arrays.
+ *
+ * \param[in] precision - precision mode
+ * \param[in] keep - variables kept in double precision
+ * \param[in] stride - count of values of each variable
+ *
+ * \return
+ * Bytes count.
+ */
+int Precision::Bytes_Count(int precision,
+                           int keep,
+                           int stride)
+{
+    int bytes = 0;
+
+    for (int v = 0; v < 6; v++)
+    {
+        bytes += Var_Bytes_Count(((keep >> v) & 1) ? Double : precision, stride);
+    }
+
+    return bytes;
+}
+
+/**
+ * \brief Encode arrays.
+ *
+ * \param[in] precision - precision mode
+ * \param[in] keep - variables kept in double precision
+ * \param[in] u - arrays
+ * \param[in] n - count of encoded values of each variable
+ * \param[in] stride - count of values of each variable in encoded buffer
+ * \param[out] p - encoded buffer
+ */
+void Precision::Encode(int precision,
+                       int keep,
+                       const Fluid_Dyn_Arrays &u,
+                       int n,
+                       int stride,
+                       char *p)
+{
+    assert(n <= stride);
+
+    for (int v = 0; v < 6; v++)
+    {
+        int pr = ((keep >> v) & 1) ? Double : precision;
+        const double *a = Var(u, v);
+
+        if (pr == Double)
+        {
+            memcpy(p, a, n * sizeof(double));
+        }
+        else if (pr == Float)
+        {
+            float *f = reinterpret_cast<float *>(p);
+
+            for (int i = 0; i < n; i++)
+            {
+                f[i] = static_cast<float>(a[i]);
+            }
+        }
+        else
+        {
+            double *h = reinterpret_cast<double *>(p);
+            unsigned short *s = reinterpret_cast<unsigned short *>(h + 2);
+            double lo = (n > 0) ? a[0] : 0.0;
+            double hi = lo;
+
+            for (int i = 1; i < n; i++)
+            {
+                lo = (a[i] < lo) ? a[i] : lo;
+                hi = (a[i] > hi) ? a[i] : hi;
+            }
+
+            double scale = (hi > lo) ? (HYDRO_GRID_PRECISION_SCALED_MAX / (hi - lo)) : 0.0;
+
+            h[0] = lo;
+            h[1] = (hi > lo) ? ((hi - lo) / HYDRO_GRID_PRECISION_SCALED_MAX) : 0.0;
+
+            for (int i = 0; i < n; i++)
+            {
+                s[i] = static_cast<unsigned short>((a[i] - lo) * scale + 0.5);
+            }
+        }
+
+        p += Var_Bytes_Count(pr, stride);
+    }
+}
+
+/**
+ * \brief Decode arrays.
+ *
+ * \param[in] precision - precision mode
+ * \param[in] keep - variables kept in double precision
+ * \param[in] p - encoded buffer
+ * \param[in] n - count of encoded values of each variable
+ * \param[in] stride - count of values of each variable in encoded buffer
+ * \param[out] u - arrays
+ */
+void Precision::Decode(int precision,
+                       int keep,
+                       const char *p,
+                       int n,
+                       int stride,
+                       Fluid_Dyn_Arrays u)
+{
+    assert(n <= stride);
+
+    for (int v = 0; v < 6; v++)
+    {
+        int pr = ((keep >> v) & 1) ? Double : precision;
+        double *a = Var(u, v);
+
+        if (pr == Double)
+        {
+            memcpy(a, p, n * sizeof(double));
+        }
+        else if (pr == Float)
+        {
+            const float *f = reinterpret_cast<const float *>(p);
+
+            for (int i = 0; i < n; i++)
+            {
+                a[i] = f[i];
+            }
+        }
+        else
+        {
+            const double *h = reinterpret_cast<const double *>(p);
+            const unsigned short *s = reinterpret_cast<const unsigned short *>(h + 2);
+
+            for (int i = 0; i < n; i++)
+            {
+                a[i] = h[0] + s[i] * h[1];
+            }
+        }
+
+        p += Var_Bytes_Count(pr, stride);
+    }
+}
+
+} }
@@ -0,0 +1,87 @@
+/**
+ * \file
+ * \brief Precision of shadow data transfer.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_GRID_PRECISION_H
+#define HYDRO_GRID_PRECISION_H
+
+#include <cassert>
+#include "Lib/IO/io.h"
+#include "Fluid_Dyn_Arrays.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Precision of shadow data transfer.
+ *
+ * Interfaces buffers keep doubles, before transfer they can be encoded:
+ * 1. Doubles are sent as they are.
+ * 2. Each value is converted to float.
+ * 3. Each value is scaled into 16-bit unsigned integer in range [min, max] of
+ *    its variable in buffer (min and max are sent with data).
+ * Selected variables can be kept in double precision.
+ *
+ * Encoded buffer is a sequence of variables parts (R, VX, VY, VZ, E, P),
+ * part keeps values of variable for all buffer cells and is aligned to double.
+ */
+class Precision
+{
+
+public:
+
+    /**
+     * \brief Precision modes enumeration.
+     */
+    enum
+    {
+        Double = 0, /**< 64-bit values */
+        Float = 1,  /**< 32-bit values */
+        Scaled = 2, /**< scaled 16-bit values */
+        Count = 3   /**< count of precision modes */
+    };
+
+    /**
+     * \brief Variables flags (for variables kept in double precision).
+     */
+    enum
+    {
+        Keep_None = 0,  /**< no variables */
+        Keep_R = 1,     /**< density */
+        Keep_VX = 2,    /**< speed x component */
+        Keep_VY = 4,    /**< speed y component */
+        Keep_VZ = 8,    /**< speed z component */
+        Keep_E = 16,    /**< energy */
+        Keep_P = 32,    /**< pressure */
+        Keep_All = 63   /**< all variables */
+    };
+
+    // Functions.
+    static string Name(int precision);
+    static int Bytes_Count(int precision,
+                           int keep,
+                           int stride);
+    static void Encode(int precision,
+                       int keep,
+                       const Fluid_Dyn_Arrays &u,
+                       int n,
+                       int stride,
+                       char *p);
+    static void Decode(int precision,
+                       int keep,
+                       const char *p,
+                       int n,
+                       int stride,
+                       Fluid_Dyn_Arrays u);
+
+private:
+
+    static int Var_Bytes_Count(int precision,
+                               int stride);
+};
+
+} }
+
+#endif
@@ -0,0 +1,310 @@
+/**
+ * \file
+ * \brief Shadow layers of block realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include <cassert>
+#include "Shadow.h"
+#include "Block.h"
+
+namespace Hydro { namespace Grid {
+
+/*
+ * Constructors/destructors.
+ */
+
+/**
+ * \brief Constructor.
+ *
+ * \param[in] b_p - block
+ */
+Shadow::Shadow(Block *b_p)
+    : B_p_(b_p),
+      Memory_p_(NULL)
+{
+    Allocate_Memory();
+}
+
+/**
+ * \brief Default destructor.
+ */
+Shadow::~Shadow()
+{
+    Deallocate_Memory();
+}
+
+/*
+ * Simple data.
+ */
+
+/**
+ * \brief Size of layer in a direction (the fastest tangent).
+ *
+ * \param[in] d - direction
+ *
+ * \return
+ * Size.
+ */
+int Shadow::A_Size(int d) const
+{
+    return ((d == Direction::I0) || (d == Direction::I1))
+           ? B_p_->J_Size()
+           : B_p_->I_Size();
+}
+
+/**
+ * \brief Size of layer in b direction (the slowest tangent).
+ *
+ * \param[in] d - direction
+ *
+ * \return
+ * Size.
+ */
+int Shadow::B_Size(int d) const
+{
+    return ((d == Direction::K0) || (d == Direction::K1))
+           ? B_p_->J_Size()
+           : B_p_->K_Size();
+}
+
+/**
+ * \brief Count of bytes.
+ *
+ * \return
+ * Count of bytes.
+ */
+long Shadow::Bytes_Count() const
+{
+    long doubles = 0;
+
+    for (int d = 0; d < Direction::Count; d++)
+    {
+        doubles += 6 * Depth() * Layer_Size(d);
+    }
+
+    return doubles * sizeof(double);
+}
+
+/*
+ * Indices.
+ */
+
+/**
+ * \brief Index of shadow cell next to the block cell.
+ *
+ * \param[in] d - direction
+ * \param[in] layer - shadow layer
+ * \param[in] i - i coordinate of block cell
+ * \param[in] j - j coordinate of block cell
+ * \param[in] k - k coordinate of block cell
+ *
+ * \return
+ * Index in layers of direction.
+ */
+int Shadow::Cell_Index(int d,
+                       int layer,
+                       int i,
+                       int j,
+                       int k) const
+{
+    int a, b;
+
+    Tangents(d, i, j, k, a, b);
+
+    return Index(d, layer, a, b);
+}
+
+/**
+ * \brief Tangent indices of block cell for direction.
+ *
+ * \param[in] d - direction
+ * \param[in] i - i coordinate
+ * \param[in] j - j coordinate
+ * \param[in] k - k coordinate
+ * \param[out] a - the fastest tangent index
+ * \param[out] b - the slowest tangent index
+ */
+void Shadow::Tangents(int d,
+                      int i,
+                      int j,
+                      int k,
+                      int &a,
+                      int &b)
+{
+    if ((d == Direction::I0) || (d == Direction::I1))
+    {
+        a = j;
+        b = k;
+    }
+    else if ((d == Direction::J0) || (d == Direction::J1))
+    {
+        a = i;
+        b = k;
+    }
+    else
+    {
+        a = i;
+        b = j;
+    }
+}
+
+/**
+ * \brief Coordinates of block cell by normal and tangent indices.
+ *
+ * \param[in] d - direction
+ * \param[in] n - normal index
+ * \param[in] a - the fastest tangent index
+ * \param[in] b - the slowest tangent index
+ * \param[out] i - i coordinate
+ * \param[out] j - j coordinate
+ * \param[out] k - k coordinate
+ */
+void Shadow::Cell(int d,
+                  int n,
+                  int a,
+                  int b,
+                  int &i,
+                  int &j,
+                  int &k)
+{
+    if ((d == Direction::I0) || (d == Direction::I1))
+    {
+        i = n;
+        j = a;
+        k = b;
+    }
+    else if ((d == Direction::J0) || (d == Direction::J1))
+    {
+        i = a;
+        j = n;
+        k = b;
+    }
+    else
+    {
+        i = a;
+        j = b;
+        k = n;
+    }
+}
+
+/**
+ * \brief Distance between block cells neighbours in a direction.
+ *
+ * \param[in] d - direction
+ * \param[in] i_size - block size in i direction
+ *
+ * \return
+ * Stride.
+ */
+int Shadow::A_Stride(int d,
+                     int i_size)
+{
+    return ((d == Direction::I0) || (d == Direction::I1))
+           ? i_size
+           : 1;
+}
+
+/*
+ * Fill layers.
+ */
+
+/**
+ * \brief Fill first layers by reflected cells of block (hard border).
+ *
+ * Shadow layer l is reflection of cells layer l (normal speed changes its sign),
+ * the deepest cells layer of thin block is used for deeper shadow layers.
+ * Directions covered by interfaces only are skipped (they are filled by interfaces).
+ *
+ * \param[in] layer - layer of cells data
+ * \param[in] depth - count of layers
+ */
+void Shadow::Reflect(int layer,
+                     int depth)
+{
+    int sizes[3] = { B_p_->I_Size(), B_p_->J_Size(), B_p_->K_Size() };
+
+    for (int d = 0; d < Direction::Count; d++)
+    {
+        if (B_p_->Get_Facet(d)->Is_Ifaces_Only())
+        {
+            continue;
+        }
+
+        int ns = sizes[d / 2];
+        int as = A_Size(d);
+        int stride = A_Stride(d, B_p_->I_Size());
+
+        for (int l = 0; l < depth; l++)
+        {
+            int ln = (l < ns) ? l : (ns - 1);
+            int n = Direction::Is_Negative(d) ? ln : (ns - 1 - ln);
+
+            for (int b = 0; b < B_Size(d); b++)
+            {
+                int i, j, k;
+                Fluid_Dyn_Arrays s = U[d].Shift(Index(d, l, 0, b));
+
+                Cell(d, n, 0, b, i, j, k);
+                B_p_->Get_Row(B_p_->Cell_Index(i, j, k), stride, as, layer, s);
+
+                double *v = s.Rotate(d).VX;
+
+                for (int a = 0; a < as; a++)
+                {
+                    v[a] = -v[a];
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Allocate/deallocate memory.
+ */
+
+/**
+ * \brief Allocate memory.
+ *
+ * \return
+ * true - if memory is allocated,
+ * false - if memory is not allocated.
+ */
+bool Shadow::Allocate_Memory()
+{
+    Deallocate_Memory();
+
+    Memory_p_ = new double[Bytes_Count() / sizeof(double)]();
+
+    if (Memory_p_ == NULL)
+    {
+        return false;
+    }
+
+    double *p = Memory_p_;
+
+    for (int d = 0; d < Direction::Count; d++)
+    {
+        int stride = Depth() * Layer_Size(d);
+
+        U[d].Set_Memory(p, stride);
+        p += 6 * stride;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Deallocate memory.
+ */
+void Shadow::Deallocate_Memory()
+{
+    if (Memory_p_ != NULL)
+    {
+        delete [] Memory_p_;
+        Memory_p_ = NULL;
+    }
+}
+
+} }
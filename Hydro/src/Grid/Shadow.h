@@ -0,0 +1,102 @@
+/**
+ * \file
+ * \brief Shadow layers of block.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_GRID_SHADOW_H
+#define HYDRO_GRID_SHADOW_H
+
+#include "Fluid_Dyn_Arrays.h"
+#include "Direction.h"
+#include "configure.h"
+
+namespace Hydro { namespace Grid {
+
+class Block;
+
+/**
+ * \brief Shadow layers of block.
+ *
+ * For each direction block has HYDRO_GRID_SHADOW_DEPTH layers of cells
+ * behind its border (layer 0 touches the border).
+ * Cells of layer are numbered by two tangent indices (a is the fastest):
+ * (j, k) for I directions, (i, k) for J directions, (i, j) for K directions,
+ * so rows of J and K layers are contiguous like rows of block cells.
+ * Layers are filled by reflected cells of block (hard border),
+ * then interfaces overwrite their parts by cells of neighbour blocks.
+ */
+class Shadow
+{
+
+public:
+
+    // Layers of all directions (structure of arrays, layer after layer).
+    Fluid_Dyn_Arrays U[Direction::Count];
+
+    // Constructors/destructors.
+    Shadow(Block *b_p);
+    ~Shadow();
+
+    // Simple data.
+    Block *B() const { return B_p_; }
+    static int Depth() { return HYDRO_GRID_SHADOW_DEPTH; }
+    int A_Size(int d) const;
+    int B_Size(int d) const;
+    int Layer_Size(int d) const { return A_Size(d) * B_Size(d); }
+    long Bytes_Count() const;
+
+    // Indices.
+    int Index(int d,
+              int layer,
+              int a,
+              int b) const { return (layer * B_Size(d) + b) * A_Size(d) + a; }
+    int Cell_Index(int d,
+                   int layer,
+                   int i,
+                   int j,
+                   int k) const;
+    static void Tangents(int d,
+                         int i,
+                         int j,
+                         int k,
+                         int &a,
+                         int &b);
+    static void Cell(int d,
+                     int n,
+                     int a,
+                     int b,
+                     int &i,
+                     int &j,
+                     int &k);
+    static int A_Stride(int d,
+                        int i_size);
+
+    // Row of shadow cells next to row of block cells.
+    Fluid_Dyn_Arrays Row(int d,
+                         int layer,
+                         int i,
+                         int j,
+                         int k) const { return U[d].Shift(Cell_Index(d, layer, i, j, k)); }
+
+    // Fill layers by reflected cells of block.
+    void Reflect(int layer,
+                 int depth);
+
+private:
+
+    // Block.
+    Block *B_p_;
+
+    // Memory.
+    double *Memory_p_;
+
+    // Allocate/deallocate memory.
+    bool Allocate_Memory();
+    void Deallocate_Memory();
+};
+
+} }
+
+#endif
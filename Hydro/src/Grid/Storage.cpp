@@ -0,0 +1,35 @@
+/**
+ * \file
+ * \brief Cells storage mode functions realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Storage.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Name of storage mode.
+ *
+ * \param[in] storage - storage mode
+ *
+ * \return
+ * Name of storage mode.
+ */
+string Storage::Name(int storage)
+{
+    switch (storage)
+    {
+        case AoS:
+            return "AoS";
+
+        case SoA:
+            return "SoA";
+
+        default:
+            assert(false);
+    }
+}
+
+} }
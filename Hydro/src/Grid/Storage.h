@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief Cells storage mode.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_GRID_STORAGE_H
+#define HYDRO_GRID_STORAGE_H
+
+#include <cassert>
+#include "Lib/IO/io.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Cells storage mode.
+ *
+ * Block cells can be stored in two ways:
+ * 1. Array of structures (array of Cell objects, each cell keeps all its data).
+ * 2. Structure of arrays (separate contiguous array for each value).
+ */
+class Storage
+{
+
+public:
+
+    /**
+     * \brief Storage modes enumeration.
+     */
+    enum
+    {
+        AoS = 0,  /**< array of structures */
+        SoA = 1,  /**< structure of arrays */
+        Count = 2 /**< count of storage modes */
+    };
+
+    // Functions.
+    static string Name(int storage);
+
+private:
+
+};
+
+} }
+
+#endif
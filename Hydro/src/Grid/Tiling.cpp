@@ -0,0 +1,140 @@
+/**
+ * \file
+ * \brief Tiling of block index space realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include <cassert>
+#include <algorithm>
+#include "Tiling.h"
+
+namespace Hydro { namespace Grid {
+
+/*
+ * Constructors/destructors.
+ */
+
+/**
+ * \brief Default constructor.
+ *
+ * Default tile is whole rows in i direction and 8 x 8 rows in j and k directions.
+ */
+Tiling::Tiling()
+    : I_Size_(0),
+      J_Size_(8),
+      K_Size_(8)
+{
+}
+
+/**
+ * \brief Constructor.
+ *
+ * \param[in] i_size - tile size in i direction
+ * \param[in] j_size - tile size in j direction
+ * \param[in] k_size - tile size in k direction
+ */
+Tiling::Tiling(int i_size,
+               int j_size,
+               int k_size)
+{
+    Set_Sizes(i_size, j_size, k_size);
+}
+
+/**
+ * \brief Set tile sizes.
+ *
+ * \param[in] i_size - tile size in i direction (0 - whole region)
+ * \param[in] j_size - tile size in j direction (0 - whole region)
+ * \param[in] k_size - tile size in k direction (0 - whole region)
+ */
+void Tiling::Set_Sizes(int i_size,
+                       int j_size,
+                       int k_size)
+{
+    assert((i_size >= 0) && (j_size >= 0) && (k_size >= 0));
+
+    I_Size_ = i_size;
+    J_Size_ = j_size;
+    K_Size_ = k_size;
+}
+
+/*
+ * Tiles.
+ */
+
+/**
+ * \brief Tiles count in one direction.
+ *
+ * \param[in] region_size - region size
+ * \param[in] tile_size - tile size (0 - whole region)
+ *
+ * \return
+ * Tiles count.
+ */
+int Tiling::Tiles(int region_size,
+                  int tile_size)
+{
+    if (region_size <= 0)
+    {
+        return 0;
+    }
+
+    if ((tile_size == 0) || (tile_size >= region_size))
+    {
+        return 1;
+    }
+
+    return (region_size + tile_size - 1) / tile_size;
+}
+
+/**
+ * \brief Tiles count in region.
+ *
+ * \param[in] region - region
+ *
+ * \return
+ * Tiles count.
+ */
+int Tiling::Count(const Box &region) const
+{
+    return Tiles(region.I_Size(), I_Size())
+           * Tiles(region.J_Size(), J_Size())
+           * Tiles(region.K_Size(), K_Size());
+}
+
+/**
+ * \brief Get tile.
+ *
+ * \param[in] region - region
+ * \param[in] n - tile number (tiles are numbered in memory order)
+ *
+ * \return
+ * Tile.
+ */
+Box Tiling::Get(const Box &region,
+                int n) const
+{
+    int ti = Tiles(region.I_Size(), I_Size());
+    int tj = Tiles(region.J_Size(), J_Size());
+    int si = (ti == 1) ? region.I_Size() : I_Size();
+    int sj = (tj == 1) ? region.J_Size() : J_Size();
+    int sk = (Tiles(region.K_Size(), K_Size()) == 1) ? region.K_Size() : K_Size();
+    int ni = n % ti;
+    int nj = (n / ti) % tj;
+    int nk = n / (ti * tj);
+    Box t;
+
+    assert((n >= 0) && (n < Count(region)));
+
+    t.I0 = region.I0 + ni * si;
+    t.I1 = min(t.I0 + si, region.I1);
+    t.J0 = region.J0 + nj * sj;
+    t.J1 = min(t.J0 + sj, region.J1);
+    t.K0 = region.K0 + nk * sk;
+    t.K1 = min(t.K0 + sk, region.K1);
+
+    return t;
+}
+
+} }
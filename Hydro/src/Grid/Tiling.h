@@ -0,0 +1,60 @@
+/**
+ * \file
+ * \brief Tiling of block index space.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_GRID_TILING_H
+#define HYDRO_GRID_TILING_H
+
+#include "Box.h"
+
+namespace Hydro { namespace Grid {
+
+/**
+ * \brief Tiling of block index space.
+ *
+ * Region (box of cells) is split into tiles of given sizes.
+ * Tiles are numbered in memory order (i is the fastest index, k is the slowest),
+ * so walking tiles by number and cells of each tile in k, j, i order
+ * walks the region in memory order with bounded working set:
+ * neighbours in j and k directions used by stencil stay in cache.
+ */
+class Tiling
+{
+
+public:
+
+    // Constructors/destructors.
+    Tiling();
+    Tiling(int i_size,
+           int j_size,
+           int k_size);
+
+    // Sizes of tile (0 means whole region size).
+    int I_Size() const { return I_Size_; }
+    int J_Size() const { return J_Size_; }
+    int K_Size() const { return K_Size_; }
+    void Set_Sizes(int i_size,
+                   int j_size,
+                   int k_size);
+
+    // Tiles.
+    int Count(const Box &region) const;
+    Box Get(const Box &region,
+            int n) const;
+
+private:
+
+    // Sizes of tile.
+    int I_Size_, J_Size_, K_Size_;
+
+    // Tiles count in each direction.
+    static int Tiles(int region_size,
+                     int tile_size);
+};
+
+} }
+
+#endif
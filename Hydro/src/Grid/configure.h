@@ -14,9 +14,10 @@
 #define HYDRO_GRID_SHADOW_DEPTH 3
 
 /**
- * \brief Count of dynamic double values per single cell.
+ * \brief Count of dynamic double values per single cell
+ * (density, speed, energy and pressure, see Fluid_Dyn_Arrays).
  */
-#define HYDRO_GRID_DYNAMIC_DOUBLES_PER_CELL 9
+#define HYDRO_GRID_DYNAMIC_DOUBLES_PER_CELL 6
 
 /*
  * Print configuration.
@@ -0,0 +1,155 @@
+/**
+ * \file
+ * \brief Flows through block faces realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Face_Flows.h"
+#include "Grid/Direction.h"
+#include <cassert>
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Count of flows arrays for each direction (R, VX, VY, VZ, E).
+ */
+#define HYDRO_SOLVER_FACE_FLOWS_ARRAYS 5
+
+/*
+ * Constructors/destructors.
+ */
+
+/**
+ * \brief Constructor.
+ *
+ * \param[in] b_p - block
+ */
+Face_Flows::Face_Flows(Block *b_p)
+    : B_p_(b_p),
+      I_Size_(b_p->I_Size()),
+      J_Size_(b_p->J_Size()),
+      K_Size_(b_p->K_Size()),
+      Memory_p_(NULL)
+{
+    Allocate_Memory();
+}
+
+/**
+ * \brief Default destructor.
+ */
+Face_Flows::~Face_Flows()
+{
+    Deallocate_Memory();
+}
+
+/*
+ * Simple data.
+ */
+
+/**
+ * \brief Get bytes count.
+ *
+ * \return
+ * Bytes count.
+ */
+long Face_Flows::Bytes_Count() const
+{
+    long faces = I_Faces_Count() + J_Faces_Count() + K_Faces_Count();
+
+    return faces * HYDRO_SOLVER_FACE_FLOWS_ARRAYS * sizeof(double);
+}
+
+/**
+ * \brief Get flows arrays which start from face of cell.
+ *
+ * \param[in] d - direction of face
+ * \param[in] i - I coordinate of cell
+ * \param[in] j - J coordinate of cell
+ * \param[in] k - K coordinate of cell
+ *
+ * \return
+ * Shifted flows arrays.
+ */
+Fluid_Dyn_Arrays Face_Flows::Cell_Face(int d,
+                                       int i,
+                                       int j,
+                                       int k) const
+{
+    switch (d)
+    {
+        case Direction::I0:
+            return I.Shift(I_Index(i, j, k));
+
+        case Direction::I1:
+            return I.Shift(I_Index(i + 1, j, k));
+
+        case Direction::J0:
+            return J.Shift(J_Index(i, j, k));
+
+        case Direction::J1:
+            return J.Shift(J_Index(i, j + 1, k));
+
+        case Direction::K0:
+            return K.Shift(K_Index(i, j, k));
+
+        case Direction::K1:
+            return K.Shift(K_Index(i, j, k + 1));
+
+        default:
+            assert(false);
+
+            return I;
+    }
+}
+
+/*
+ * Allocate/deallocate memory.
+ */
+
+/**
+ * \brief Allocate memory.
+ *
+ * \return
+ * true - if memory is allocated,
+ * false - if memory is not allocated.
+ */
+bool Face_Flows::Allocate_Memory()
+{
+    const int n = HYDRO_SOLVER_FACE_FLOWS_ARRAYS;
+    int ic = I_Faces_Count();
+    int jc = J_Faces_Count();
+    int kc = K_Faces_Count();
+
+    Deallocate_Memory();
+
+    Memory_p_ = new double[n * (ic + jc + kc)];
+
+    if (Memory_p_ == NULL)
+    {
+        return false;
+    }
+
+    I.Set_Memory(Memory_p_, ic);
+    I.P = NULL;
+    J.Set_Memory(Memory_p_ + n * ic, jc);
+    J.P = NULL;
+    K.Set_Memory(Memory_p_ + n * (ic + jc), kc);
+    K.P = NULL;
+
+    return true;
+}
+
+/**
+ * \brief Deallocate memory.
+ */
+void Face_Flows::Deallocate_Memory()
+{
+    if (Memory_p_ != NULL)
+    {
+        delete [] Memory_p_;
+        Memory_p_ = NULL;
+    }
+}
+
+} }
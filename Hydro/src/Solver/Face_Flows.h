@@ -0,0 +1,77 @@
+/**
+ * \file
+ * \brief Flows through block faces.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_FACE_FLOWS_H
+#define HYDRO_SOLVER_FACE_FLOWS_H
+
+#include "Grid/Block.h"
+
+using namespace Hydro::Grid;
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Flows through block faces.
+ *
+ * For each direction (I, J, K) there are arrays of flows
+ * of density (R), momentum (VX, VY, VZ) and full energy (E)
+ * through faces orthogonal to this direction (P array is not used).
+ * Flow is positive if it goes in positive direction, flow is multiplied by face square.
+ *
+ * Face with index i in I direction lays between cells i - 1 and i,
+ * so faces 0 and I_Size are block borders (the same for J and K).
+ * Faces are linearized like cells (i is the fastest index).
+ */
+class Face_Flows
+{
+
+public:
+
+    // Flows through faces in I, J, K directions.
+    Fluid_Dyn_Arrays I, J, K;
+
+    // Constructors/destructors.
+    Face_Flows(Block *b_p);
+    ~Face_Flows();
+
+    // Simple data.
+    Block *B() const { return B_p_; }
+    int I_Index(int i, int j, int k) const { return (k * J_Size_ + j) * (I_Size_ + 1) + i; }
+    int J_Index(int i, int j, int k) const { return (k * (J_Size_ + 1) + j) * I_Size_ + i; }
+    int K_Index(int i, int j, int k) const { return (k * J_Size_ + j) * I_Size_ + i; }
+    long Bytes_Count() const;
+
+    // Flows from face of cell in given direction.
+    Fluid_Dyn_Arrays Cell_Face(int d,
+                               int i,
+                               int j,
+                               int k) const;
+
+private:
+
+    // Block.
+    Block *B_p_;
+
+    // Block sizes.
+    int I_Size_, J_Size_, K_Size_;
+
+    // Memory.
+    double *Memory_p_;
+
+    // Allocate/deallocate memory.
+    bool Allocate_Memory();
+    void Deallocate_Memory();
+
+    // Faces count.
+    int I_Faces_Count() const { return (I_Size_ + 1) * J_Size_ * K_Size_; }
+    int J_Faces_Count() const { return I_Size_ * (J_Size_ + 1) * K_Size_; }
+    int K_Faces_Count() const { return I_Size_ * J_Size_ * (K_Size_ + 1); }
+};
+
+} }
+
+#endif
@@ -5,8 +5,14 @@
  * \author Alexey Rybakov
  */
 
+#include <sched.h>
 #include "Godunov_1.h"
 #include "Riemann.h"
+#include "Riemann_HLL.h"
+#include "Riemann_HLLC.h"
+#include "Riemann_Roe.h"
+#include "Row_Kernels.h"
+#include "Lib/MPI/mpi.h"
 #include "Lib/OMP/omp.h"
 
 namespace Hydro { namespace Solver {
@@ -16,11 +22,203 @@ namespace Hydro { namespace Solver {
  *
  * \param[in] g_p - grid pointer
  */
-Godunov_1::Godunov_1(Hydro::Grid::Grid *g_p)
-    : G_p_(g_p)
+template <class Riemann_Solver>
+Godunov_1<Riemann_Solver>::Godunov_1(Hydro::Grid::Grid *g_p)
+    : G_p_(g_p),
+      Scheme_(Scheme::Reference),
+      Schedule_(Schedule::Blocks),
+      Traversal_(Traversal::Memory),
+      Time_Step_(g_p),
+      Tiling_(),
+      Threads_Timer_(),
+      Threads_Memory_(),
+      Face_Flows_Count_(0),
+      Face_Flows_p_(NULL)
 {
 }
 
+/**
+ * \brief Default destructor.
+ */
+template <class Riemann_Solver>
+Godunov_1<Riemann_Solver>::~Godunov_1()
+{
+    Deallocate_Face_Flows();
+}
+
+/**
+ * \brief Set scheme.
+ *
+ * Faces flows schemes work with structure of arrays,
+ * so reference scheme is set instead of them for array of structures storage.
+ * Reference scheme is calculated only by blocks schedule, so it is set for reference scheme.
+ *
+ * \param[in] scheme - scheme
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Set_Scheme(int scheme)
+{
+    assert((scheme >= 0) && (scheme < Scheme::Count));
+
+    if ((scheme != Scheme::Reference) && (G_p_->Storage() != Storage::SoA))
+    {
+        if (Lib::MPI::Rank() == 0)
+        {
+            cout << "Wrn: " << Scheme::Name(scheme) << " scheme needs structure of arrays storage, "
+                 << "reference scheme is used instead of it." << endl;
+        }
+
+        scheme = Scheme::Reference;
+    }
+
+    Scheme_ = scheme;
+
+    if ((Scheme_ == Scheme::Reference) && (Schedule_ != Schedule::Blocks))
+    {
+        if (Lib::MPI::Rank() == 0)
+        {
+            cout << "Wrn: " << Schedule::Name(Schedule_) << " schedule needs faces flows scheme, "
+                 << "blocks schedule is used instead of it." << endl;
+        }
+
+        Schedule_ = Schedule::Blocks;
+    }
+}
+
+/**
+ * \brief Set schedule.
+ *
+ * Tasks and overlap schedules are made for faces flows schemes,
+ * so blocks schedule is set instead of them for reference scheme.
+ * Progress schedule calls MPI from master thread while other threads calculate,
+ * so it needs MPI initialized with MPI_THREAD_FUNNELED at least,
+ * otherwise overlap schedule is set instead of it.
+ *
+ * \param[in] schedule - schedule
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Set_Schedule(int schedule)
+{
+    assert((schedule >= 0) && (schedule < Schedule::Count));
+
+    if ((schedule != Schedule::Blocks) && (Scheme_ == Scheme::Reference))
+    {
+        if (Lib::MPI::Rank() == 0)
+        {
+            cout << "Wrn: " << Schedule::Name(schedule) << " schedule needs faces flows scheme, "
+                 << "blocks schedule is used instead of it." << endl;
+        }
+
+        schedule = Schedule::Blocks;
+    }
+
+    if (schedule == Schedule::Progress)
+    {
+        int provided;
+
+        MPI_Query_thread(&provided);
+
+        if (provided < MPI_THREAD_FUNNELED)
+        {
+            if (Lib::MPI::Rank() == 0)
+            {
+                cout << "Wrn: MPI does not support threads, "
+                     << "overlap schedule is used instead of progress one." << endl;
+            }
+
+            schedule = Schedule::Overlap;
+        }
+    }
+
+    Schedule_ = schedule;
+}
+
+/*
+ * Faces flows.
+ */
+
+/**
+ * \brief Get faces flows of block.
+ *
+ * Faces flows are allocated on first request.
+ *
+ * \param[in] b_p - block
+ *
+ * \return
+ * Faces flows.
+ */
+template <class Riemann_Solver>
+Face_Flows *Godunov_1<Riemann_Solver>::Get_Face_Flows(Block *b_p)
+{
+    int id = b_p->Id();
+
+    if (Face_Flows_Count_ != G_p_->Blocks_Count())
+    {
+        Deallocate_Face_Flows();
+        Face_Flows_Count_ = G_p_->Blocks_Count();
+        Face_Flows_p_ = new Face_Flows *[Face_Flows_Count_];
+
+        for (int i = 0; i < Face_Flows_Count_; i++)
+        {
+            Face_Flows_p_[i] = NULL;
+        }
+    }
+
+    assert((id >= 0) && (id < Face_Flows_Count_));
+
+    if (Face_Flows_p_[id] == NULL)
+    {
+        Face_Flows_p_[id] = new Face_Flows(b_p);
+    }
+
+    assert(Face_Flows_p_[id]->B() == b_p);
+
+    return Face_Flows_p_[id];
+}
+
+/**
+ * \brief Free faces flows of blocks which are not active (migrated to other ranks).
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Free_Inactive_Face_Flows()
+{
+    if (Face_Flows_Count_ != G_p_->Blocks_Count())
+    {
+        return;
+    }
+
+    for (int i = 0; i < Face_Flows_Count_; i++)
+    {
+        if ((Face_Flows_p_[i] != NULL) && !G_p_->Get_Block(i)->Is_Active())
+        {
+            delete Face_Flows_p_[i];
+            Face_Flows_p_[i] = NULL;
+        }
+    }
+}
+
+/**
+ * \brief Deallocate faces flows.
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Deallocate_Face_Flows()
+{
+    if (Face_Flows_p_ != NULL)
+    {
+        for (int i = 0; i < Face_Flows_Count_; i++)
+        {
+            if (Face_Flows_p_[i] != NULL)
+            {
+                delete Face_Flows_p_[i];
+            }
+        }
+
+        delete [] Face_Flows_p_;
+        Face_Flows_p_ = NULL;
+        Face_Flows_Count_ = 0;
+    }
+}
+
 /*
  * Calculations.
  */
@@ -31,8 +229,9 @@ Godunov_1::Godunov_1(Hydro::Grid::Grid *g_p)
  * \param[in] count - iterations count
  * \param[in] dt - time step
  */
-void Godunov_1::Calc_Iters(int count,
-                           double dt)
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iters(int count,
+                                           double dt)
 {
     for (int i = 0; i < count; i++)
     {
@@ -45,169 +244,1386 @@ void Godunov_1::Calc_Iters(int count,
  *
  * \param[in] dt - time step
  */
-void Godunov_1::Calc_Iter(double dt)
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iter(double dt)
 {
-    for (int i = 0; i < G_p_->Blocks_Count(); i++)
+    // Wall time includes shadows exchange (schedules hide it differently).
+    Threads_Timer_.Start();
+    Threads_Memory_.Init();
+    Free_Inactive_Face_Flows();
+
+    // States behind block borders are taken from shadow layers
+    // (overlap schedules exchange them themselves).
+    if ((Schedule_ != Schedule::Overlap) && (Schedule_ != Schedule::Progress))
+    {
+        G_p_->Exchange_Shadows(1);
+    }
+
+    if (Schedule_ == Schedule::Tasks)
+    {
+        Calc_Iter_Tasks(dt);
+    }
+    else if (Schedule_ == Schedule::Overlap)
+    {
+        Calc_Iter_Overlap(dt);
+    }
+    else if (Schedule_ == Schedule::Progress)
     {
-        Calc_Iter(G_p_->Get_Block(i), dt);
+        Calc_Iter_Progress(dt);
+    }
+    else
+    {
+        for (int i = 0; i < G_p_->Blocks_Count(); i++)
+        {
+            Block *b_p = G_p_->Get_Block(i);
+
+            if (b_p->Is_Active())
+            {
+                double start = omp_get_wtime();
+
+                Calc_Iter(b_p, dt);
+                b_p->Add_Calc_Time(omp_get_wtime() - start);
+            }
+        }
     }
 
+    Threads_Timer_.Stop();
+
     G_p_->Swap_Layers();
+    G_p_->Register_Time_Step(dt);
 }
 
 /**
- * \brief Iteration calculation for single block.
+ * \brief Iterations calculation with time step from CFL number.
  *
- * \param[in,out] b_p - block pointer
- * \param[in] dt - time step
+ * \param[in] count - iterations count
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iters(int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        Calc_Iter();
+    }
+}
+
+/**
+ * \brief Iteration calculation with time step from CFL number.
  *
- * \TODO:
- * We suggest i is x Descartes coordinate,
- *            j is y Descartes coordinate,
- *            k is Z Descartes coordinate.
+ * \return
+ * Time step.
  */
-void Godunov_1::Calc_Iter(Block *b_p,
-                          double dt)
+template <class Riemann_Solver>
+double Godunov_1<Riemann_Solver>::Calc_Iter()
 {
-    int i_size = b_p->I_Size();
-    int j_size = b_p->J_Size();
-    int k_size = b_p->K_Size();
-    int cur = b_p->Get_Grid()->Layer();
-    int nxt = cur ^ 1;
+    double dt = Time_Step_.Calc_Dt();
 
-    b_p->Copy_Cur_Layer_To_Nxt();
-    b_p->Nxt_Normal_To_Expand();
+    Calc_Iter(dt);
+
+    return dt;
+}
+
+/**
+ * \brief Iterations calculation until given physical time.
+ *
+ * Time step is calculated from CFL number,
+ * the last step is cut to finish exactly at given time.
+ *
+ * \param[in] t - final physical time
+ *
+ * \return
+ * Iterations count.
+ */
+template <class Riemann_Solver>
+int Godunov_1<Riemann_Solver>::Calc_Until(double t)
+{
+    int count = 0;
+    bool is_last = (G_p_->Time() >= t);
 
-    #pragma omp parallel for
-    for (int i = 0; i < i_size; i++)
+    while (!is_last)
     {
-        for (int j = 0; j < j_size; j++)
-        {
-            for (int k = 0; k < k_size; k++)
-            {
-                Cell *c1_p = b_p->Get_Cell(i, j, k);
-                Cell *c2_p = NULL;
-                Fluid_Dyn_Pars u;
-                double sd = 0.0;
-                double d = dt / c1_p->Vo;
+        double dt = Time_Step_.Calc_Dt();
+        double rest = t - G_p_->Time();
 
-                // I.
+        if (dt >= rest)
+        {
+            dt = rest;
+            is_last = true;
+        }
 
-                // I0 direction (x-).
-                sd = c1_p->S[Direction::I0] * d;
-                if (i == 0)
-                {
-                    // Hard border.
+        Calc_Iter(dt);
+        count++;
+    }
 
-                    Fluid_Dyn_Pars u2 = c1_p->U[cur];
+    return count;
+}
 
-                    u2.V.X *= -1.0;
-                    Riemann::Avg(&c1_p->U[cur], &u2, &u);
+/**
+ * \brief Iteration calculation for all blocks as tasks.
+ *
+ * Tiles of all blocks are tasks of one parallel region,
+ * so threads are not joined after each block and take tasks of the next blocks
+ * while the last tiles of the current block are calculated.
+ * Two phase scheme waits for all flows tasks before cells update tasks.
+ *
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iter_Tasks(double dt)
+{
+    // Tasks are made for faces flows schemes.
+    assert((Scheme_ == Scheme::Two_Phase) || (Scheme_ == Scheme::Fused));
 
-                    c1_p->U[nxt].Flow_X(-u.DR_X() * sd, -u.DV_X() * sd, -u.DE_X() * sd);
-                }
+    int blocks_count = G_p_->Blocks_Count();
+    int phases_count = (Scheme_ == Scheme::Two_Phase) ? 2 : 1;
 
-                // I1 direction (x+).
-                sd = c1_p->S[Direction::I1] * d;
-                if (i == i_size - 1)
+    #pragma omp parallel
+    {
+        // Tasks are created by one thread (faces flows are allocated by it too),
+        // all threads of region take them.
+        #pragma omp single
+        {
+            for (int p = 0; p < phases_count; p++)
+            {
+                for (int i = 0; i < blocks_count; i++)
                 {
-                    // Hard border.
+                    Block *b_p = G_p_->Get_Block(i);
 
-                    Fluid_Dyn_Pars u2 = c1_p->U[cur];
+                    if (!b_p->Is_Active())
+                    {
+                        continue;
+                    }
 
-                    u2.V.X *= -1.0;
-                    Riemann::Avg(&c1_p->U[cur], &u2, &u);
+                    Face_Flows *f_p = (Scheme_ == Scheme::Two_Phase) ? Get_Face_Flows(b_p) : NULL;
+                    Box region = b_p->Get_Box();
+                    int tiles_count = Tiling_.Count(region);
 
-                    c1_p->U[nxt].Flow_X(u.DR_X() * sd, u.DV_X() * sd, u.DE_X() * sd);
-                }
-                else
-                {
-                    c2_p = b_p->Get_Cell(i + 1, j, k);
-                    Riemann::Avg(&c1_p->U[cur], &c2_p->U[cur], &u);
+                    // Scheme works with structure of arrays.
+                    assert(b_p->Is_SoA());
+
+                    for (int t = 0; t < tiles_count; t++)
+                    {
+                        #pragma omp task firstprivate(b_p, f_p, region, t, p)
+                        {
+                            double start = Threads_Timer_.Job_Start();
+                            Box tile = Tiling_.Get(region, t);
+
+                            if (Scheme_ == Scheme::Fused)
+                            {
+                                Calc_Tile_Fused(b_p, tile, dt);
+                            }
+                            else if (p == 0)
+                            {
+                                Calc_Tile_Flows(b_p, f_p, tile);
+                            }
+                            else
+                            {
+                                Calc_Tile_Cells(b_p, f_p, tile, dt);
+                            }
 
-                    c1_p->U[nxt].Flow_X(c2_p->U[nxt], u.DR_X() * sd, u.DV_X() * sd, u.DE_X() * sd);
+                            Threads_Timer_.Job_Stop(start);
+                            b_p->Add_Calc_Time(omp_get_wtime() - start);
+                        }
+                    }
                 }
 
-                // J.
+                #pragma omp taskwait
+            }
+        }
+    }
+}
 
-                // J0 direction (y-).
-                sd = c1_p->S[Direction::J0] * d;
-                if (j == 0)
-                {
-                    // Hard border.
+/**
+ * \brief Iteration calculation with overlap of shadows exchange and inner cells calculation.
+ *
+ * Shadows of block borders with interfaces to blocks of other ranks are delivered by MPI,
+ * so only cells near these borders (shell of block) wait for the exchange.
+ * Other cells are calculated while messages are in flight (MPI is tested between blocks),
+ * blocks without such borders are calculated entirely before the exchange is finished.
+ *
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iter_Overlap(double dt)
+{
+    // Overlap is made for faces flows schemes.
+    assert((Scheme_ == Scheme::Two_Phase) || (Scheme_ == Scheme::Fused));
 
-                    Fluid_Dyn_Pars u2 = c1_p->U[cur];
+    int blocks_count = G_p_->Blocks_Count();
 
-                    u2.V.Y *= -1.0;
-                    Riemann::Avg(&c1_p->U[cur], &u2, &u);
+    G_p_->Start_Exchange_Shadows(1);
 
-                    c1_p->U[nxt].Flow_Y(-u.DR_Y() * sd, -u.DV_Y() * sd, -u.DE_Y() * sd);
-                }
+    // Inner cells.
+    for (int i = 0; i < blocks_count; i++)
+    {
+        Block *b_p = G_p_->Get_Block(i);
 
-                // J1 direction (y+).
-                sd = c1_p->S[Direction::J1] * d;
-                if (j == j_size - 1)
-                {
-                    // Hard border.
+        if (b_p->Is_Active())
+        {
+            double start = omp_get_wtime();
+
+            Calc_Block_Inner(b_p, dt);
+            b_p->Add_Calc_Time(omp_get_wtime() - start);
+            G_p_->Test_Exchange_Shadows();
+        }
+    }
 
-                    Fluid_Dyn_Pars u2 = c1_p->U[cur];
+    G_p_->Finish_Exchange_Shadows();
 
-                    u2.V.Y *= -1.0;
-                    Riemann::Avg(&c1_p->U[cur], &u2, &u);
+    // Shells.
+    for (int i = 0; i < blocks_count; i++)
+    {
+        Block *b_p = G_p_->Get_Block(i);
 
-                    c1_p->U[nxt].Flow_Y(u.DR_Y() * sd, u.DV_Y() * sd, u.DE_Y() * sd);
-                }
-                else
-                {
-                    c2_p = b_p->Get_Cell(i, j + 1, k);
-                    Riemann::Avg(&c1_p->U[cur], &c2_p->U[cur], &u);
+        if (b_p->Is_Active())
+        {
+            double start = omp_get_wtime();
 
-                    c1_p->U[nxt].Flow_Y(c2_p->U[nxt], u.DR_Y() * sd, u.DV_Y() * sd, u.DE_Y() * sd);
-                }
+            Calc_Block_Shell(b_p, dt);
+            b_p->Add_Calc_Time(omp_get_wtime() - start);
+        }
+    }
+}
 
-                // K.
+/**
+ * \brief Iteration calculation with shadows exchange driven by dedicated thread.
+ *
+ * One thread tests messages and unpacks interfaces as soon as they are delivered,
+ * so exchange progresses even if MPI library has no asynchronous progress.
+ * Other threads (nested team) calculate inner cells of all blocks and then shell of each
+ * block as soon as all its interfaces are unpacked.
+ * Exchange thread is the master thread (thread 0 of region started by it), the only one
+ * which calls MPI, so MPI_THREAD_FUNNELED support is enough (checked by Set_Schedule).
+ * Exchange thread and calculating thread waiting for shadows yield processor between tests.
+ *
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iter_Progress(double dt)
+{
+    // Overlap is made for faces flows schemes.
+    assert((Scheme_ == Scheme::Two_Phase) || (Scheme_ == Scheme::Fused));
 
-                // K0 direction (z-).
-                sd = c1_p->S[Direction::K0] * d;
-                if (k == 0)
-                {
-                    // Hard border.
+    int blocks_count = G_p_->Blocks_Count();
+    int workers_count = max(omp_get_max_threads() - 1, 1);
+    int max_levels = omp_get_max_active_levels();
 
-                    Fluid_Dyn_Pars u2 = c1_p->U[cur];
+    G_p_->Start_Exchange_Shadows(1);
+    omp_set_max_active_levels(2);
 
-                    u2.V.Z *= -1.0;
-                    Riemann::Avg(&c1_p->U[cur], &u2, &u);
+    #pragma omp parallel num_threads(2)
+    {
+        if (omp_get_thread_num() == 0)
+        {
+            // Exchange progress.
+            while (!G_p_->Progress_Exchange_Shadows())
+            {
+                sched_yield();
+            }
+        }
+        else
+        {
+            omp_set_num_threads(workers_count);
 
-                    c1_p->U[nxt].Flow_Z(-u.DR_Z() * sd, -u.DV_Z() * sd, -u.DE_Z() * sd);
-                }
+            // Inner cells.
+            for (int i = 0; i < blocks_count; i++)
+            {
+                Block *b_p = G_p_->Get_Block(i);
 
-                // K1 direction (z+).
-                sd = c1_p->S[Direction::K1] * d;
-                if (k == k_size - 1)
+                if (b_p->Is_Active())
                 {
-                    // Hard border.
+                    double start = omp_get_wtime();
 
-                    Fluid_Dyn_Pars u2 = c1_p->U[cur];
+                    Calc_Block_Inner(b_p, dt);
+                    b_p->Add_Calc_Time(omp_get_wtime() - start);
+                }
+            }
 
-                    u2.V.Z *= -1.0;
-                    Riemann::Avg(&c1_p->U[cur], &u2, &u);
+            // Shells of blocks in order of their readiness.
+            vector<bool> is_done(blocks_count, false);
+            int left = 0;
 
-                    c1_p->U[nxt].Flow_Z(u.DR_Z() * sd, u.DV_Z() * sd, u.DE_Z() * sd);
+            for (int i = 0; i < blocks_count; i++)
+            {
+                if (G_p_->Get_Block(i)->Is_Active())
+                {
+                    left++;
                 }
                 else
                 {
-                    c2_p = b_p->Get_Cell(i, j, k + 1);
-                    Riemann::Avg(&c1_p->U[cur], &c2_p->U[cur], &u);
+                    is_done[i] = true;
+                }
+            }
+
+            while (left > 0)
+            {
+                int ready = 0;
+
+                for (int i = 0; i < blocks_count; i++)
+                {
+                    if (!is_done[i] && G_p_->Is_Block_Shadows_Ready(i))
+                    {
+                        Block *b_p = G_p_->Get_Block(i);
+                        double start = omp_get_wtime();
 
-                    c1_p->U[nxt].Flow_Z(c2_p->U[nxt], u.DR_Z() * sd, u.DV_Z() * sd, u.DE_Z() * sd);
+                        Calc_Block_Shell(b_p, dt);
+                        b_p->Add_Calc_Time(omp_get_wtime() - start);
+                        is_done[i] = true;
+                        left--;
+                        ready++;
+                    }
+                }
+
+                // Wait for shadows without busy spinning.
+                if (ready == 0)
+                {
+                    sched_yield();
                 }
             }
         }
     }
 
-    // Restore real speed vector.
-    b_p->Nxt_Expand_To_Normal();
+    omp_set_max_active_levels(max_levels);
+    G_p_->Finish_Exchange_Shadows();
 }
 
-} }
+/**
+ * \brief Split block into inner cells and shell of cells near remote borders.
+ *
+ * \param[in] b_p - block pointer
+ * \param[out] is_remote - remote borders flags (for all directions)
+ * \param[out] inner - inner cells
+ * \param[out] shell - shell parts (for all directions)
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Split_Block(Block *b_p,
+                                            int *is_remote,
+                                            Box &inner,
+                                            Box *shell)
+{
+    for (int d = 0; d < Direction::Count; d++)
+    {
+        is_remote[d] = b_p->Get_Facet(d)->Has_Remote_Ifaces() ? 1 : 0;
+    }
+
+    // Shell depth is 1 for remote borders and 0 for others.
+    b_p->Get_Box().Split_Shell(is_remote, inner, shell);
+}
+
+/**
+ * \brief Calculation of inner cells of block (remote shadows are not used).
+ *
+ * Two phase scheme calculates all inner faces flows and flows through local borders here.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Block_Inner(Block *b_p,
+                                                 double dt)
+{
+    // Scheme works with structure of arrays.
+    assert(b_p->Is_SoA());
+
+    int is_remote[Direction::Count];
+    Box inner, shell[Direction::Count];
+
+    Split_Block(b_p, is_remote, inner, shell);
+
+    if (Scheme_ == Scheme::Fused)
+    {
+        Calc_Region_Fused(b_p, inner, dt);
+
+        return;
+    }
 
+    Face_Flows *f_p = Get_Face_Flows(b_p);
+    Box region = b_p->Get_Box();
+    int tiles_count = Tiling_.Count(region);
+
+    #pragma omp parallel for schedule(static, 1)
+    for (int t = 0; t < tiles_count; t++)
+    {
+        double start = Threads_Timer_.Job_Start();
+        Box tile = Tiling_.Get(region, t);
+
+        Calc_Tile_Inner_Flows(b_p, f_p, tile);
+        for (int d = 0; d < Direction::Count; d++)
+        {
+            if (!is_remote[d])
+            {
+                Calc_Tile_Border_Flows(b_p, f_p, tile, d);
+            }
+        }
+        Threads_Timer_.Job_Stop(start);
+    }
+
+    Calc_Region_Cells(b_p, f_p, inner, dt);
+}
+
+/**
+ * \brief Calculation of shell cells of block (after shadows exchange).
+ *
+ * Two phase scheme calculates flows through remote borders here.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Block_Shell(Block *b_p,
+                                                 double dt)
+{
+    int is_remote[Direction::Count];
+    Box inner, shell[Direction::Count];
+
+    Split_Block(b_p, is_remote, inner, shell);
+
+    if (Scheme_ == Scheme::Fused)
+    {
+        for (int d = 0; d < Direction::Count; d++)
+        {
+            Calc_Region_Fused(b_p, shell[d], dt);
+        }
+
+        return;
+    }
+
+    Face_Flows *f_p = Get_Face_Flows(b_p);
+    Box region = b_p->Get_Box();
+
+    // Flows through remote borders (by tiles of border layers).
+    for (int d = 0; d < Direction::Count; d++)
+    {
+        Box border;
+
+        if (!is_remote[d] || !region.Get_Border(region, d, border))
+        {
+            continue;
+        }
+
+        int tiles_count = Tiling_.Count(border);
+
+        #pragma omp parallel for schedule(static, 1)
+        for (int t = 0; t < tiles_count; t++)
+        {
+            double start = Threads_Timer_.Job_Start();
+
+            Calc_Tile_Border_Flows(b_p, f_p, Tiling_.Get(border, t), d);
+            Threads_Timer_.Job_Stop(start);
+        }
+    }
+
+    for (int d = 0; d < Direction::Count; d++)
+    {
+        Calc_Region_Cells(b_p, f_p, shell[d], dt);
+    }
+}
+
+/**
+ * \brief Iteration calculation for single block.
+ *
+ * Reference scheme keeps original calculation with averaged values
+ * (Riemann solver policy is used only by faces flows schemes).
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iter(Block *b_p,
+                                          double dt)
+{
+    if (Scheme_ == Scheme::Two_Phase)
+    {
+        Calc_Iter_Two_Phase(b_p, dt);
+    }
+    else if (Scheme_ == Scheme::Fused)
+    {
+        Calc_Iter_Fused(b_p, dt);
+    }
+    else if (b_p->Is_SoA())
+    {
+        Calc_Iter_SoA(b_p, dt);
+    }
+    else
+    {
+        Calc_Iter_AoS(b_p, dt);
+    }
+}
+
+/**
+ * \brief Iteration calculation for single block (array of structures storage).
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iter_AoS(Block *b_p,
+                                              double dt)
+{
+    int i_size = b_p->I_Size();
+    int j_size = b_p->J_Size();
+    int k_size = b_p->K_Size();
+
+    b_p->Copy_Cur_Layer_To_Nxt();
+    b_p->Nxt_Normal_To_Expand();
+
+    if (Traversal_ == Traversal::Legacy)
+    {
+        #pragma omp parallel for
+        for (int i = 0; i < i_size; i++)
+        {
+            for (int j = 0; j < j_size; j++)
+            {
+                for (int k = 0; k < k_size; k++)
+                {
+                    Calc_Cell_AoS(b_p, i, j, k, dt);
+                }
+            }
+        }
+    }
+    else
+    {
+        Box region = b_p->Get_Box();
+        int tiles_count = Tiling_.Count(region);
+
+        #pragma omp parallel for schedule(static, 1)
+        for (int t = 0; t < tiles_count; t++)
+        {
+            Box tile = Tiling_.Get(region, t);
+
+            for (int k = tile.K0; k < tile.K1; k++)
+            {
+                for (int j = tile.J0; j < tile.J1; j++)
+                {
+                    for (int i = tile.I0; i < tile.I1; i++)
+                    {
+                        Calc_Cell_AoS(b_p, i, j, k, dt);
+                    }
+                }
+            }
+        }
+    }
+
+    // Restore real speed vector.
+    b_p->Nxt_Expand_To_Normal();
+}
+
+/**
+ * \brief Iteration calculation for single block (structure of arrays storage).
+ *
+ * The same scheme as for array of structures storage,
+ * but each value is taken from its own array.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iter_SoA(Block *b_p,
+                                              double dt)
+{
+    int i_size = b_p->I_Size();
+    int j_size = b_p->J_Size();
+    int k_size = b_p->K_Size();
+
+    b_p->Copy_Cur_Layer_To_Nxt();
+    b_p->Nxt_Normal_To_Expand();
+
+    if (Traversal_ == Traversal::Legacy)
+    {
+        #pragma omp parallel for
+        for (int i = 0; i < i_size; i++)
+        {
+            for (int j = 0; j < j_size; j++)
+            {
+                for (int k = 0; k < k_size; k++)
+                {
+                    Calc_Cell_SoA(b_p, i, j, k, dt);
+                }
+            }
+        }
+    }
+    else
+    {
+        Box region = b_p->Get_Box();
+        int tiles_count = Tiling_.Count(region);
+
+        #pragma omp parallel for schedule(static, 1)
+        for (int t = 0; t < tiles_count; t++)
+        {
+            Box tile = Tiling_.Get(region, t);
+
+            for (int k = tile.K0; k < tile.K1; k++)
+            {
+                for (int j = tile.J0; j < tile.J1; j++)
+                {
+                    for (int i = tile.I0; i < tile.I1; i++)
+                    {
+                        Calc_Cell_SoA(b_p, i, j, k, dt);
+                    }
+                }
+            }
+        }
+    }
+
+    // Restore real speed vector.
+    b_p->Nxt_Expand_To_Normal();
+}
+
+/**
+ * \brief Calculation for single cell (array of structures storage).
+ *
+ * Cell takes flows through all its edges,
+ * flow through positive edge is also given to neighbour cell,
+ * flows through block borders are calculated with cells of shadow layers.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] i - i coordinate
+ * \param[in] j - j coordinate
+ * \param[in] k - k coordinate
+ * \param[in] dt - time step
+ *
+ * \TODO:
+ * We suggest i is x Descartes coordinate,
+ *            j is y Descartes coordinate,
+ *            k is Z Descartes coordinate.
+ */
+template <class Riemann_Solver>
+inline void Godunov_1<Riemann_Solver>::Calc_Cell_AoS(Block *b_p,
+                                                     int i,
+                                                     int j,
+                                                     int k,
+                                                     double dt)
+{
+    int i_size = b_p->I_Size();
+    int j_size = b_p->J_Size();
+    int k_size = b_p->K_Size();
+    int cur = b_p->Get_Grid()->Layer();
+    int nxt = cur ^ 1;
+    const Shadow *sh_p = b_p->Shadows;
+    Cell *c1_p = b_p->Get_Cell(i, j, k);
+    Cell *c2_p = NULL;
+    Fluid_Dyn_Pars u;
+    double sd = 0.0;
+    double d = dt / c1_p->Vo;
+
+    // I.
+
+    // I0 direction (x-).
+    sd = c1_p->S[Direction::I0] * d;
+    if (i == 0)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        Fluid_Dyn_Pars u2;
+
+        sh_p->U[Direction::I0].Get(sh_p->Cell_Index(Direction::I0, 0, i, j, k), u2);
+        Riemann::Avg(&c1_p->U[cur], &u2, &u);
+
+        c1_p->U[nxt].Flow_X(-u.DR_X() * sd, -u.DV_X() * sd, -u.DE_X() * sd);
+    }
+
+    // I1 direction (x+).
+    sd = c1_p->S[Direction::I1] * d;
+    if (i == i_size - 1)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        Fluid_Dyn_Pars u2;
+
+        sh_p->U[Direction::I1].Get(sh_p->Cell_Index(Direction::I1, 0, i, j, k), u2);
+        Riemann::Avg(&c1_p->U[cur], &u2, &u);
+
+        c1_p->U[nxt].Flow_X(u.DR_X() * sd, u.DV_X() * sd, u.DE_X() * sd);
+    }
+    else
+    {
+        c2_p = b_p->Get_Cell(i + 1, j, k);
+        Riemann::Avg(&c1_p->U[cur], &c2_p->U[cur], &u);
+
+        c1_p->U[nxt].Flow_X(c2_p->U[nxt], u.DR_X() * sd, u.DV_X() * sd, u.DE_X() * sd);
+    }
+
+    // J.
+
+    // J0 direction (y-).
+    sd = c1_p->S[Direction::J0] * d;
+    if (j == 0)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        Fluid_Dyn_Pars u2;
+
+        sh_p->U[Direction::J0].Get(sh_p->Cell_Index(Direction::J0, 0, i, j, k), u2);
+        Riemann::Avg(&c1_p->U[cur], &u2, &u);
+
+        c1_p->U[nxt].Flow_Y(-u.DR_Y() * sd, -u.DV_Y() * sd, -u.DE_Y() * sd);
+    }
+
+    // J1 direction (y+).
+    sd = c1_p->S[Direction::J1] * d;
+    if (j == j_size - 1)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        Fluid_Dyn_Pars u2;
+
+        sh_p->U[Direction::J1].Get(sh_p->Cell_Index(Direction::J1, 0, i, j, k), u2);
+        Riemann::Avg(&c1_p->U[cur], &u2, &u);
+
+        c1_p->U[nxt].Flow_Y(u.DR_Y() * sd, u.DV_Y() * sd, u.DE_Y() * sd);
+    }
+    else
+    {
+        c2_p = b_p->Get_Cell(i, j + 1, k);
+        Riemann::Avg(&c1_p->U[cur], &c2_p->U[cur], &u);
+
+        c1_p->U[nxt].Flow_Y(c2_p->U[nxt], u.DR_Y() * sd, u.DV_Y() * sd, u.DE_Y() * sd);
+    }
+
+    // K.
+
+    // K0 direction (z-).
+    sd = c1_p->S[Direction::K0] * d;
+    if (k == 0)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        Fluid_Dyn_Pars u2;
+
+        sh_p->U[Direction::K0].Get(sh_p->Cell_Index(Direction::K0, 0, i, j, k), u2);
+        Riemann::Avg(&c1_p->U[cur], &u2, &u);
+
+        c1_p->U[nxt].Flow_Z(-u.DR_Z() * sd, -u.DV_Z() * sd, -u.DE_Z() * sd);
+    }
+
+    // K1 direction (z+).
+    sd = c1_p->S[Direction::K1] * d;
+    if (k == k_size - 1)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        Fluid_Dyn_Pars u2;
+
+        sh_p->U[Direction::K1].Get(sh_p->Cell_Index(Direction::K1, 0, i, j, k), u2);
+        Riemann::Avg(&c1_p->U[cur], &u2, &u);
+
+        c1_p->U[nxt].Flow_Z(u.DR_Z() * sd, u.DV_Z() * sd, u.DE_Z() * sd);
+    }
+    else
+    {
+        c2_p = b_p->Get_Cell(i, j, k + 1);
+        Riemann::Avg(&c1_p->U[cur], &c2_p->U[cur], &u);
+
+        c1_p->U[nxt].Flow_Z(c2_p->U[nxt], u.DR_Z() * sd, u.DV_Z() * sd, u.DE_Z() * sd);
+    }
+}
+
+/**
+ * \brief Calculation for single cell (structure of arrays storage).
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] i - i coordinate
+ * \param[in] j - j coordinate
+ * \param[in] k - k coordinate
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+inline void Godunov_1<Riemann_Solver>::Calc_Cell_SoA(Block *b_p,
+                                                     int i,
+                                                     int j,
+                                                     int k,
+                                                     double dt)
+{
+    int i_size = b_p->I_Size();
+    int j_size = b_p->J_Size();
+    int k_size = b_p->K_Size();
+    int cur = b_p->Get_Grid()->Layer();
+    int nxt = cur ^ 1;
+    Cells_SoA *soa_p = b_p->SoA;
+    const Shadow *sh_p = b_p->Shadows;
+    const Fluid_Dyn_Arrays uc = soa_p->U[cur];
+    const Fluid_Dyn_Arrays un = soa_p->U[nxt];
+    const double *vo = soa_p->Vo;
+    const double *s_i0 = soa_p->S[Direction::I0];
+    const double *s_i1 = soa_p->S[Direction::I1];
+    const double *s_j0 = soa_p->S[Direction::J0];
+    const double *s_j1 = soa_p->S[Direction::J1];
+    const double *s_k0 = soa_p->S[Direction::K0];
+    const double *s_k1 = soa_p->S[Direction::K1];
+    int c1 = b_p->Cell_Index(i, j, k);
+    int c2;
+    Fluid_Dyn_Pars u1, u2, u;
+    double sd = 0.0;
+    double d = dt / vo[c1];
+
+    uc.Get(c1, u1);
+
+    // I.
+
+    // I0 direction (x-).
+    sd = s_i0[c1] * d;
+    if (i == 0)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        sh_p->U[Direction::I0].Get(sh_p->Cell_Index(Direction::I0, 0, i, j, k), u2);
+        Riemann::Avg(&u1, &u2, &u);
+
+        un.R[c1] += u.DR_X() * sd;
+        un.VX[c1] += u.DV_X() * sd;
+        un.E[c1] += u.DE_X() * sd;
+    }
+
+    // I1 direction (x+).
+    sd = s_i1[c1] * d;
+    if (i == i_size - 1)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        sh_p->U[Direction::I1].Get(sh_p->Cell_Index(Direction::I1, 0, i, j, k), u2);
+        Riemann::Avg(&u1, &u2, &u);
+
+        un.R[c1] -= u.DR_X() * sd;
+        un.VX[c1] -= u.DV_X() * sd;
+        un.E[c1] -= u.DE_X() * sd;
+    }
+    else
+    {
+        c2 = c1 + 1;
+        uc.Get(c2, u2);
+        Riemann::Avg(&u1, &u2, &u);
+
+        double dr = u.DR_X() * sd;
+        double dv = u.DV_X() * sd;
+        double de = u.DE_X() * sd;
+
+        un.R[c1] -= dr;
+        un.VX[c1] -= dv;
+        un.E[c1] -= de;
+        un.R[c2] += dr;
+        un.VX[c2] += dv;
+        un.E[c2] += de;
+    }
+
+    // J.
+
+    // J0 direction (y-).
+    sd = s_j0[c1] * d;
+    if (j == 0)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        sh_p->U[Direction::J0].Get(sh_p->Cell_Index(Direction::J0, 0, i, j, k), u2);
+        Riemann::Avg(&u1, &u2, &u);
+
+        un.R[c1] += u.DR_Y() * sd;
+        un.VY[c1] += u.DV_Y() * sd;
+        un.E[c1] += u.DE_Y() * sd;
+    }
+
+    // J1 direction (y+).
+    sd = s_j1[c1] * d;
+    if (j == j_size - 1)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        sh_p->U[Direction::J1].Get(sh_p->Cell_Index(Direction::J1, 0, i, j, k), u2);
+        Riemann::Avg(&u1, &u2, &u);
+
+        un.R[c1] -= u.DR_Y() * sd;
+        un.VY[c1] -= u.DV_Y() * sd;
+        un.E[c1] -= u.DE_Y() * sd;
+    }
+    else
+    {
+        c2 = c1 + i_size;
+        uc.Get(c2, u2);
+        Riemann::Avg(&u1, &u2, &u);
+
+        double dr = u.DR_Y() * sd;
+        double dv = u.DV_Y() * sd;
+        double de = u.DE_Y() * sd;
+
+        un.R[c1] -= dr;
+        un.VY[c1] -= dv;
+        un.E[c1] -= de;
+        un.R[c2] += dr;
+        un.VY[c2] += dv;
+        un.E[c2] += de;
+    }
+
+    // K.
+
+    // K0 direction (z-).
+    sd = s_k0[c1] * d;
+    if (k == 0)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        sh_p->U[Direction::K0].Get(sh_p->Cell_Index(Direction::K0, 0, i, j, k), u2);
+        Riemann::Avg(&u1, &u2, &u);
+
+        un.R[c1] += u.DR_Z() * sd;
+        un.VZ[c1] += u.DV_Z() * sd;
+        un.E[c1] += u.DE_Z() * sd;
+    }
+
+    // K1 direction (z+).
+    sd = s_k1[c1] * d;
+    if (k == k_size - 1)
+    {
+        // Border (cell of neighbour block or reflected cell from shadow layer).
+
+        sh_p->U[Direction::K1].Get(sh_p->Cell_Index(Direction::K1, 0, i, j, k), u2);
+        Riemann::Avg(&u1, &u2, &u);
+
+        un.R[c1] -= u.DR_Z() * sd;
+        un.VZ[c1] -= u.DV_Z() * sd;
+        un.E[c1] -= u.DE_Z() * sd;
+    }
+    else
+    {
+        c2 = c1 + i_size * j_size;
+        uc.Get(c2, u2);
+        Riemann::Avg(&u1, &u2, &u);
+
+        double dr = u.DR_Z() * sd;
+        double dv = u.DV_Z() * sd;
+        double de = u.DE_Z() * sd;
+
+        un.R[c1] -= dr;
+        un.VZ[c1] -= dv;
+        un.E[c1] -= de;
+        un.R[c2] += dr;
+        un.VZ[c2] += dv;
+        un.E[c2] += de;
+    }
+}
+
+/**
+ * \brief Iteration calculation for single block in two phases.
+ *
+ * First phase calculates flow through each face once and stores it in faces flows.
+ * Second phase updates cells, each cell takes flows through its faces and
+ * writes only itself, so there are no data races between threads.
+ * Second phase also does copy of current layer, moving to expand form and back,
+ * so it is the only pass over next layer.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iter_Two_Phase(Block *b_p,
+                                                    double dt)
+{
+    // Scheme works with structure of arrays.
+    assert(b_p->Is_SoA());
+
+    Face_Flows *f_p = Get_Face_Flows(b_p);
+    Box region = b_p->Get_Box();
+    int tiles_count = Tiling_.Count(region);
+
+    // Faces flows.
+    #pragma omp parallel for schedule(static, 1)
+    for (int t = 0; t < tiles_count; t++)
+    {
+        double start = Threads_Timer_.Job_Start();
+
+        Calc_Tile_Flows(b_p, f_p, Tiling_.Get(region, t));
+        Threads_Timer_.Job_Stop(start);
+    }
+
+    Calc_Region_Cells(b_p, f_p, region, dt);
+}
+
+/**
+ * \brief Calculate faces flows for tile.
+ *
+ * Tile calculates flows through its negative faces,
+ * tiles on the positive block borders also calculate flows through the border faces.
+ * So tiles of block calculate each face exactly once.
+ * Inner faces are calculated by rows without branches,
+ * block border faces are calculated by border kernels (one for each direction).
+ *
+ * \param[in] b_p - block pointer
+ * \param[out] f_p - faces flows
+ * \param[in] tile - tile
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Tile_Flows(Block *b_p,
+                                                Face_Flows *f_p,
+                                                const Box &tile)
+{
+    Calc_Tile_Inner_Flows(b_p, f_p, tile);
+
+    // Block borders.
+    for (int d = 0; d < Direction::Count; d++)
+    {
+        Calc_Tile_Border_Flows(b_p, f_p, tile, d);
+    }
+}
+
+/**
+ * \brief Calculate inner faces flows for tile (faces with block cells on both sides).
+ *
+ * \param[in] b_p - block pointer
+ * \param[out] f_p - faces flows
+ * \param[in] tile - tile
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Tile_Inner_Flows(Block *b_p,
+                                                      Face_Flows *f_p,
+                                                      const Box &tile)
+{
+    int i_size = b_p->I_Size();
+    int ij_size = i_size * b_p->J_Size();
+    int cur = b_p->Get_Grid()->Layer();
+    Cells_SoA *soa_p = b_p->SoA;
+    const Fluid_Dyn_Arrays uc = soa_p->U[cur];
+    const double *s_i1 = soa_p->S[Direction::I1];
+    const double *s_j1 = soa_p->S[Direction::J1];
+    const double *s_k1 = soa_p->S[Direction::K1];
+    int n = tile.I_Size();
+
+    // Inner faces are faces with cells on both sides.
+    int i0 = (tile.I0 == 0) ? 1 : tile.I0;
+    int j0 = (tile.J0 == 0) ? 1 : tile.J0;
+    int k0 = (tile.K0 == 0) ? 1 : tile.K0;
+
+    // I inner faces.
+    for (int k = tile.K0; k < tile.K1; k++)
+    {
+        for (int j = tile.J0; j < tile.J1; j++)
+        {
+            int c = b_p->Cell_Index(i0, j, k);
+
+            Row_Kernels::Faces_Flows<Riemann_Solver>(uc.Shift(c - 1), uc.Shift(c), s_i1 + c - 1,
+                                                     tile.I1 - i0, Direction::I0,
+                                                     f_p->I.Shift(f_p->I_Index(i0, j, k)));
+        }
+    }
+
+    // J inner faces.
+    for (int k = tile.K0; k < tile.K1; k++)
+    {
+        for (int j = j0; j < tile.J1; j++)
+        {
+            int c = b_p->Cell_Index(tile.I0, j, k);
+
+            Row_Kernels::Faces_Flows<Riemann_Solver>(uc.Shift(c - i_size), uc.Shift(c),
+                                                     s_j1 + c - i_size, n, Direction::J0,
+                                                     f_p->J.Shift(f_p->J_Index(tile.I0, j, k)));
+        }
+    }
+
+    // K inner faces.
+    for (int k = k0; k < tile.K1; k++)
+    {
+        for (int j = tile.J0; j < tile.J1; j++)
+        {
+            int c = b_p->Cell_Index(tile.I0, j, k);
+
+            Row_Kernels::Faces_Flows<Riemann_Solver>(uc.Shift(c - ij_size), uc.Shift(c),
+                                                     s_k1 + c - ij_size, n, Direction::K0,
+                                                     f_p->K.Shift(f_p->K_Index(tile.I0, j, k)));
+        }
+    }
+}
+
+/**
+ * \brief Calculate flows through block border faces of tile in given direction.
+ *
+ * Nothing is done if tile does not touch the border.
+ * States behind the border are taken from the first shadow layer.
+ *
+ * \param[in] b_p - block pointer
+ * \param[out] f_p - faces flows
+ * \param[in] tile - tile
+ * \param[in] d - direction of border
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Tile_Border_Flows(Block *b_p,
+                                                       Face_Flows *f_p,
+                                                       const Box &tile,
+                                                       int d)
+{
+    Box border;
+
+    // Tile does not touch the border.
+    if (!tile.Get_Border(b_p->Get_Box(), d, border))
+    {
+        return;
+    }
+
+    int cur = b_p->Get_Grid()->Layer();
+    Cells_SoA *soa_p = b_p->SoA;
+    const Shadow *sh_p = b_p->Shadows;
+
+    for (int k = border.K0; k < border.K1; k++)
+    {
+        for (int j = border.J0; j < border.J1; j++)
+        {
+            int c = b_p->Cell_Index(border.I0, j, k);
+            int g = sh_p->Cell_Index(d, 0, border.I0, j, k);
+
+            Row_Kernels::Border_Flows<Riemann_Solver>(soa_p->U[cur].Shift(c), sh_p->U[d].Shift(g),
+                                                      soa_p->S[d] + c, border.I_Size(), d,
+                                                      f_p->Cell_Face(d, border.I0, j, k));
+        }
+    }
+}
+
+/**
+ * \brief Update cells of region by faces flows (parallel loop over tiles).
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] f_p - faces flows
+ * \param[in] region - region of block
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Region_Cells(Block *b_p,
+                                                  const Face_Flows *f_p,
+                                                  const Box &region,
+                                                  double dt)
+{
+    int tiles_count = Tiling_.Count(region);
+
+    #pragma omp parallel for schedule(static, 1)
+    for (int t = 0; t < tiles_count; t++)
+    {
+        double start = Threads_Timer_.Job_Start();
+
+        Calc_Tile_Cells(b_p, f_p, Tiling_.Get(region, t), dt);
+        Threads_Timer_.Job_Stop(start);
+    }
+}
+
+/**
+ * \brief Update cells of tile by faces flows.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] f_p - faces flows
+ * \param[in] tile - tile
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Tile_Cells(Block *b_p,
+                                                const Face_Flows *f_p,
+                                                const Box &tile,
+                                                double dt)
+{
+    int i_size = b_p->I_Size();
+    int ij_size = i_size * b_p->J_Size();
+    int cur = b_p->Get_Grid()->Layer();
+    int nxt = cur ^ 1;
+    Cells_SoA *soa_p = b_p->SoA;
+
+    for (int k = tile.K0; k < tile.K1; k++)
+    {
+        for (int j = tile.J0; j < tile.J1; j++)
+        {
+            int c0 = b_p->Cell_Index(tile.I0, j, k);
+            const Fluid_Dyn_Arrays fi = f_p->I.Shift(f_p->I_Index(tile.I0, j, k));
+            const Fluid_Dyn_Arrays fj = f_p->J.Shift(f_p->J_Index(tile.I0, j, k));
+            const Fluid_Dyn_Arrays fk = f_p->K.Shift(f_p->K_Index(tile.I0, j, k));
+
+            Row_Kernels::Update(soa_p->U[cur].Shift(c0), soa_p->U[nxt].Shift(c0), soa_p->Vo + c0,
+                                tile.I_Size(), dt,
+                                fi, fi.Shift(1), fj, fj.Shift(i_size), fk, fk.Shift(ij_size));
+        }
+    }
+}
+
+/**
+ * \brief Iteration calculation for single block in one fused pass.
+ *
+ * Each row of cells calculates flows through its faces
+ * into small tile buffers and immediately updates its cells,
+ * so the block is walked once: current layer is read and next layer is written.
+ * Flows through positive J and K faces are kept for the next row and the next plane of tile,
+ * so only faces on tiles borders are calculated twice.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Iter_Fused(Block *b_p,
+                                                double dt)
+{
+    // Scheme works with structure of arrays.
+    assert(b_p->Is_SoA());
+
+    Calc_Region_Fused(b_p, b_p->Get_Box(), dt);
+}
+
+/**
+ * \brief Fused calculation of region of block (parallel loop over tiles).
+ *
+ * Tiles calculate flows through all faces of their cells,
+ * so region may be any part of block.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] region - region of block
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Region_Fused(Block *b_p,
+                                                  const Box &region,
+                                                  double dt)
+{
+    int tiles_count = Tiling_.Count(region);
+
+    #pragma omp parallel for schedule(static, 1)
+    for (int t = 0; t < tiles_count; t++)
+    {
+        double start = Threads_Timer_.Job_Start();
+
+        Calc_Tile_Fused(b_p, Tiling_.Get(region, t), dt);
+        Threads_Timer_.Job_Stop(start);
+    }
+}
+
+/**
+ * \brief Fused calculation of tile.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] tile - tile
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_1<Riemann_Solver>::Calc_Tile_Fused(Block *b_p,
+                                                const Box &tile,
+                                                double dt)
+{
+    int i_size = b_p->I_Size();
+    int j_size = b_p->J_Size();
+    int k_size = b_p->K_Size();
+    int ij_size = i_size * j_size;
+    int cur = b_p->Get_Grid()->Layer();
+    int nxt = cur ^ 1;
+    Cells_SoA *soa_p = b_p->SoA;
+    int n = tile.I_Size();
+    int plane = n * tile.J_Size();
+
+    // Buffers for flows through I faces of row, J faces of two rows and K faces of two planes.
+    const Shadow *sh_p = b_p->Shadows;
+    int i_stride = n + 1;
+    double *buf = Threads_Memory_.Get(6 * (i_stride + 2 * n + 2 * plane));
+    Fluid_Dyn_Arrays fi, fj[2], fk[2];
+    fi.Set_Memory(buf, i_stride);
+    fj[0].Set_Memory(buf + 6 * i_stride, n);
+    fj[1].Set_Memory(buf + 6 * (i_stride + n), n);
+    fk[0].Set_Memory(buf + 6 * (i_stride + 2 * n), plane);
+    fk[1].Set_Memory(buf + 6 * (i_stride + 2 * n + plane), plane);
+    int k_lo = 0;
+
+    // Inner I faces of row (faces with cells on both sides): [fi0, fi1).
+    int fi0 = (tile.I0 == 0) ? 1 : 0;
+    int fi1 = (tile.I1 == i_size) ? n : (n + 1);
+
+    for (int k = tile.K0; k < tile.K1; k++)
+    {
+        int j_lo = 0;
+
+        for (int j = tile.J0; j < tile.J1; j++)
+        {
+            int c0 = b_p->Cell_Index(tile.I0, j, k);
+            const Fluid_Dyn_Arrays uc = soa_p->U[cur].Shift(c0);
+            const double *s_i0 = soa_p->S[Direction::I0] + c0;
+            const double *s_i1 = soa_p->S[Direction::I1] + c0;
+            const double *s_j0 = soa_p->S[Direction::J0] + c0;
+            const double *s_j1 = soa_p->S[Direction::J1] + c0;
+            const double *s_k0 = soa_p->S[Direction::K0] + c0;
+            const double *s_k1 = soa_p->S[Direction::K1] + c0;
+            const Fluid_Dyn_Arrays fj0 = fj[j_lo];
+            const Fluid_Dyn_Arrays fj1 = fj[j_lo ^ 1];
+            const Fluid_Dyn_Arrays fk0 = fk[k_lo].Shift((j - tile.J0) * n);
+            const Fluid_Dyn_Arrays fk1 = fk[k_lo ^ 1].Shift((j - tile.J0) * n);
+
+            // I faces: inner faces by one call, block borders by border kernels.
+            Row_Kernels::Faces_Flows<Riemann_Solver>(uc.Shift(fi0 - 1), uc.Shift(fi0),
+                                                     s_i1 + fi0 - 1, fi1 - fi0,
+                                                     Direction::I0, fi.Shift(fi0));
+            if (tile.I0 == 0)
+            {
+                const Fluid_Dyn_Arrays g = sh_p->Row(Direction::I0, 0, 0, j, k);
+
+                Row_Kernels::Border_Flows<Riemann_Solver>(uc, g, s_i0, 1, Direction::I0, fi);
+            }
+            if (tile.I1 == i_size)
+            {
+                const Fluid_Dyn_Arrays g = sh_p->Row(Direction::I1, 0, 0, j, k);
+
+                Row_Kernels::Border_Flows<Riemann_Solver>(uc.Shift(n - 1), g, s_i1 + n - 1, 1,
+                                                          Direction::I1, fi.Shift(n));
+            }
+
+            // J faces: negative faces are taken from the previous row.
+            if (j == 0)
+            {
+                const Fluid_Dyn_Arrays g = sh_p->Row(Direction::J0, 0, tile.I0, j, k);
+
+                Row_Kernels::Border_Flows<Riemann_Solver>(uc, g, s_j0, n, Direction::J0, fj0);
+            }
+            else if (j == tile.J0)
+            {
+                Row_Kernels::Faces_Flows<Riemann_Solver>(uc.Shift(-i_size), uc, s_j1 - i_size, n,
+                                                         Direction::J0, fj0);
+            }
+            if (j == j_size - 1)
+            {
+                const Fluid_Dyn_Arrays g = sh_p->Row(Direction::J1, 0, tile.I0, j, k);
+
+                Row_Kernels::Border_Flows<Riemann_Solver>(uc, g, s_j1, n, Direction::J1, fj1);
+            }
+            else
+            {
+                Row_Kernels::Faces_Flows<Riemann_Solver>(uc, uc.Shift(i_size), s_j1, n,
+                                                         Direction::J0, fj1);
+            }
+
+            // K faces: negative faces are taken from the previous plane.
+            if (k == 0)
+            {
+                const Fluid_Dyn_Arrays g = sh_p->Row(Direction::K0, 0, tile.I0, j, k);
+
+                Row_Kernels::Border_Flows<Riemann_Solver>(uc, g, s_k0, n, Direction::K0, fk0);
+            }
+            else if (k == tile.K0)
+            {
+                Row_Kernels::Faces_Flows<Riemann_Solver>(uc.Shift(-ij_size), uc, s_k1 - ij_size, n,
+                                                         Direction::K0, fk0);
+            }
+            if (k == k_size - 1)
+            {
+                const Fluid_Dyn_Arrays g = sh_p->Row(Direction::K1, 0, tile.I0, j, k);
+
+                Row_Kernels::Border_Flows<Riemann_Solver>(uc, g, s_k1, n, Direction::K1, fk1);
+            }
+            else
+            {
+                Row_Kernels::Faces_Flows<Riemann_Solver>(uc, uc.Shift(ij_size), s_k1, n,
+                                                         Direction::K0, fk1);
+            }
+
+            Row_Kernels::Update(uc, soa_p->U[nxt].Shift(c0), soa_p->Vo + c0, n, dt,
+                                fi, fi.Shift(1), fj0, fj1, fk0, fk1);
+
+            j_lo ^= 1;
+        }
+
+        k_lo ^= 1;
+    }
+}
+
+/*
+ * Explicit instantiations (solvers policies).
+ */
+
+template class Godunov_1<Riemann_Avg>;
+template class Godunov_1<Riemann_HLL>;
+template class Godunov_1<Riemann_HLLC>;
+template class Godunov_1<Riemann_Roe>;
+
+} }
@@ -9,6 +9,14 @@
 #define HYDRO_SOLVER_GODUNOV_1_H
 
 #include "Grid/Grid.h"
+#include "Grid/Tiling.h"
+#include "Traversal.h"
+#include "Scheme.h"
+#include "Schedule.h"
+#include "Face_Flows.h"
+#include "Time_Step.h"
+#include "Riemann_Avg.h"
+#include "Lib/OMP/omp.h"
 
 using namespace Hydro::Grid;
 
@@ -16,29 +24,162 @@ namespace Hydro { namespace Solver {
 
 /**
  * \brief Godunov method.
+ *
+ * Riemann solver is a policy (Riemann_Avg, Riemann_HLL, Riemann_HLLC, Riemann_Roe),
+ * it is used by faces flows schemes (Two_Phase, Fused),
+ * reference scheme always uses averaged values.
+ * Class is instantiated for all solvers in Godunov_1.cpp.
+ * Faces flows schemes can be scheduled as tasks (tiles of all blocks in one parallel region)
+ * or with overlap of shadows exchange and inner cells calculation
+ * (shadows exchange can be driven by dedicated thread),
+ * busy time of threads is accumulated for their tiles jobs.
+ * Calculation time of each block is accumulated in block for grid rebalancing
+ * (tasks schedule sums times of block tiles).
  */
+template <class Riemann_Solver = Riemann_Avg>
 class Godunov_1
 {
 
 public:
 
-    // Default constructor.
+    // Constructors/destructors.
     Godunov_1(Hydro::Grid::Grid *g_p);
+    ~Godunov_1();
+
+    // Scheme settings.
+    int Get_Scheme() const { return Scheme_; }
+    void Set_Scheme(int scheme);
+
+    // Schedule settings.
+    int Get_Schedule() const { return Schedule_; }
+    void Set_Schedule(int schedule);
 
+    // Traversal settings.
+    int Get_Traversal() const { return Traversal_; }
+    void Set_Traversal(int traversal) { Traversal_ = traversal; }
+    const Tiling &Get_Tiling() const { return Tiling_; }
+    void Set_Tiles(int i_size,
+                   int j_size,
+                   int k_size) { Tiling_.Set_Sizes(i_size, j_size, k_size); }
+
+    // Time step settings.
+    double Get_CFL() const { return Time_Step_.Get_CFL(); }
+    void Set_CFL(double cfl) { Time_Step_.Set_CFL(cfl); }
 
     // Iterations.
     void Calc_Iters(int count,
                     double dt);
     void Calc_Iter(double dt);
 
+    // Iterations with time step from CFL number.
+    void Calc_Iters(int count);
+    double Calc_Iter();
+    int Calc_Until(double t);
+
+    // Threads busy and idle times.
+    Lib::OMP::Threads_Timer &Get_Threads_Timer() { return Threads_Timer_; }
+
 private:
 
     // Grid.
     Hydro::Grid::Grid *G_p_;
 
+    // Block update scheme.
+    int Scheme_;
+
+    // Schedule of blocks calculation.
+    int Schedule_;
+
+    // Cells traversal order.
+    int Traversal_;
+
+    // Time step control.
+    Time_Step Time_Step_;
+
+    // Tiling for memory traversal.
+    Tiling Tiling_;
+
+    // Threads times.
+    Lib::OMP::Threads_Timer Threads_Timer_;
+
+    // Work memory of threads (flows buffers of tiles).
+    Lib::OMP::Threads_Memory Threads_Memory_;
+
+    // Faces flows of blocks (for two phase scheme).
+    int Face_Flows_Count_;
+    Face_Flows **Face_Flows_p_;
+
+    // Faces flows.
+    Face_Flows *Get_Face_Flows(Block *b_p);
+    void Free_Inactive_Face_Flows();
+    void Deallocate_Face_Flows();
+
+    // Iteration for all blocks as tasks.
+    void Calc_Iter_Tasks(double dt);
+
+    // Iteration with overlap of shadows exchange and inner cells calculation.
+    void Calc_Iter_Overlap(double dt);
+    void Calc_Iter_Progress(double dt);
+    void Split_Block(Block *b_p,
+                     int *is_remote,
+                     Box &inner,
+                     Box *shell);
+    void Calc_Block_Inner(Block *b_p,
+                          double dt);
+    void Calc_Block_Shell(Block *b_p,
+                          double dt);
+
     // Iteration for block.
     void Calc_Iter(Block *b_p,
                    double dt);
+    void Calc_Iter_AoS(Block *b_p,
+                       double dt);
+    void Calc_Iter_SoA(Block *b_p,
+                       double dt);
+
+    // Calculation for single cell.
+    void Calc_Cell_AoS(Block *b_p,
+                       int i,
+                       int j,
+                       int k,
+                       double dt);
+    void Calc_Cell_SoA(Block *b_p,
+                       int i,
+                       int j,
+                       int k,
+                       double dt);
+
+    // Two phase scheme.
+    void Calc_Iter_Two_Phase(Block *b_p,
+                             double dt);
+    void Calc_Tile_Flows(Block *b_p,
+                         Face_Flows *f_p,
+                         const Box &tile);
+    void Calc_Tile_Inner_Flows(Block *b_p,
+                               Face_Flows *f_p,
+                               const Box &tile);
+    void Calc_Tile_Border_Flows(Block *b_p,
+                                Face_Flows *f_p,
+                                const Box &tile,
+                                int d);
+    void Calc_Region_Cells(Block *b_p,
+                           const Face_Flows *f_p,
+                           const Box &region,
+                           double dt);
+    void Calc_Tile_Cells(Block *b_p,
+                         const Face_Flows *f_p,
+                         const Box &tile,
+                         double dt);
+
+    // Fused scheme.
+    void Calc_Iter_Fused(Block *b_p,
+                         double dt);
+    void Calc_Region_Fused(Block *b_p,
+                           const Box &region,
+                           double dt);
+    void Calc_Tile_Fused(Block *b_p,
+                         const Box &tile,
+                         double dt);
 };
 
 } }
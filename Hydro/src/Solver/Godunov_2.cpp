@@ -0,0 +1,942 @@
+/**
+ * \file
+ * \brief Godunov method order of accuracy 2 (MUSCL-Hancock) realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Godunov_2.h"
+#include "Riemann_Avg.h"
+#include "Riemann_HLL.h"
+#include "Riemann_Roe.h"
+#include "Row_Kernels.h"
+#include "Lib/MPI/mpi.h"
+#include "Lib/OMP/omp.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Default constructor.
+ *
+ * \param[in] g_p - grid pointer
+ */
+template <class Riemann_Solver>
+Godunov_2<Riemann_Solver>::Godunov_2(Hydro::Grid::Grid *g_p)
+    : G_p_(g_p),
+      Limiter_(Limiter::Minmod),
+      Time_Step_(g_p),
+      Tiling_(),
+      Threads_Memory_(),
+      Blocks_Data_Count_(0),
+      Face_Flows_p_(NULL),
+      Reconstructions_p_(NULL)
+{
+    if (!Is_Storage_Supported() && (Lib::MPI::Rank() == 0))
+    {
+        cout << "Err: Godunov_2 needs structure of arrays storage, "
+             << "iterations are not calculated." << endl;
+    }
+}
+
+/**
+ * \brief Default destructor.
+ */
+template <class Riemann_Solver>
+Godunov_2<Riemann_Solver>::~Godunov_2()
+{
+    Deallocate_Blocks_Data();
+}
+
+/*
+ * Data of blocks.
+ */
+
+/**
+ * \brief Check arrays of blocks data.
+ *
+ * Arrays are reallocated if count of blocks is changed.
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Check_Blocks_Data()
+{
+    if (Blocks_Data_Count_ != G_p_->Blocks_Count())
+    {
+        Deallocate_Blocks_Data();
+        Blocks_Data_Count_ = G_p_->Blocks_Count();
+        Face_Flows_p_ = new Face_Flows *[Blocks_Data_Count_];
+        Reconstructions_p_ = new Reconstruction *[Blocks_Data_Count_];
+
+        for (int i = 0; i < Blocks_Data_Count_; i++)
+        {
+            Face_Flows_p_[i] = NULL;
+            Reconstructions_p_[i] = NULL;
+        }
+    }
+}
+
+/**
+ * \brief Get faces flows of block.
+ *
+ * Faces flows are allocated on first request.
+ *
+ * \param[in] b_p - block
+ *
+ * \return
+ * Faces flows.
+ */
+template <class Riemann_Solver>
+Face_Flows *Godunov_2<Riemann_Solver>::Get_Face_Flows(Block *b_p)
+{
+    int id = b_p->Id();
+
+    Check_Blocks_Data();
+    assert((id >= 0) && (id < Blocks_Data_Count_));
+
+    if (Face_Flows_p_[id] == NULL)
+    {
+        Face_Flows_p_[id] = new Face_Flows(b_p);
+    }
+
+    assert(Face_Flows_p_[id]->B() == b_p);
+
+    return Face_Flows_p_[id];
+}
+
+/**
+ * \brief Get reconstruction of block.
+ *
+ * Reconstruction is allocated on first request.
+ *
+ * \param[in] b_p - block
+ *
+ * \return
+ * Reconstruction.
+ */
+template <class Riemann_Solver>
+Reconstruction *Godunov_2<Riemann_Solver>::Get_Reconstruction(Block *b_p)
+{
+    int id = b_p->Id();
+
+    Check_Blocks_Data();
+    assert((id >= 0) && (id < Blocks_Data_Count_));
+
+    if (Reconstructions_p_[id] == NULL)
+    {
+        Reconstructions_p_[id] = new Reconstruction(b_p);
+    }
+
+    assert(Reconstructions_p_[id]->B() == b_p);
+
+    return Reconstructions_p_[id];
+}
+
+/**
+ * \brief Free data of blocks which are not active (migrated to other ranks).
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Free_Inactive_Blocks_Data()
+{
+    Check_Blocks_Data();
+
+    for (int i = 0; i < Blocks_Data_Count_; i++)
+    {
+        if (G_p_->Get_Block(i)->Is_Active())
+        {
+            continue;
+        }
+
+        if (Face_Flows_p_[i] != NULL)
+        {
+            delete Face_Flows_p_[i];
+            Face_Flows_p_[i] = NULL;
+        }
+
+        if (Reconstructions_p_[i] != NULL)
+        {
+            delete Reconstructions_p_[i];
+            Reconstructions_p_[i] = NULL;
+        }
+    }
+}
+
+/**
+ * \brief Deallocate data of blocks.
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Deallocate_Blocks_Data()
+{
+    if (Face_Flows_p_ != NULL)
+    {
+        for (int i = 0; i < Blocks_Data_Count_; i++)
+        {
+            if (Face_Flows_p_[i] != NULL)
+            {
+                delete Face_Flows_p_[i];
+            }
+
+            if (Reconstructions_p_[i] != NULL)
+            {
+                delete Reconstructions_p_[i];
+            }
+        }
+
+        delete [] Face_Flows_p_;
+        delete [] Reconstructions_p_;
+        Face_Flows_p_ = NULL;
+        Reconstructions_p_ = NULL;
+        Blocks_Data_Count_ = 0;
+    }
+}
+
+/*
+ * Calculations.
+ */
+
+/**
+ * \brief Iterations calculation.
+ *
+ * \param[in] count - iterations count
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Calc_Iters(int count,
+                                           double dt)
+{
+    for (int i = 0; i < count; i++)
+    {
+        Calc_Iter(dt);
+    }
+}
+
+/**
+ * \brief Iteration calculation.
+ *
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Calc_Iter(double dt)
+{
+    // Scheme works with structure of arrays (error is reported by constructor).
+    if (!Is_Storage_Supported())
+    {
+        return;
+    }
+
+    // Slopes and states behind block borders are taken from shadow layers.
+    G_p_->Exchange_Shadows(2);
+    Threads_Memory_.Init();
+    Free_Inactive_Blocks_Data();
+
+    for (int i = 0; i < G_p_->Blocks_Count(); i++)
+    {
+        Block *b_p = G_p_->Get_Block(i);
+
+        if (b_p->Is_Active())
+        {
+            double start = omp_get_wtime();
+
+            Calc_Iter(b_p, dt);
+            b_p->Add_Calc_Time(omp_get_wtime() - start);
+        }
+    }
+
+    G_p_->Swap_Layers();
+    G_p_->Register_Time_Step(dt);
+}
+
+/**
+ * \brief Iterations calculation with time step from CFL number.
+ *
+ * \param[in] count - iterations count
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Calc_Iters(int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        Calc_Iter();
+    }
+}
+
+/**
+ * \brief Iteration calculation with time step from CFL number.
+ *
+ * \return
+ * Time step.
+ */
+template <class Riemann_Solver>
+double Godunov_2<Riemann_Solver>::Calc_Iter()
+{
+    double dt = Time_Step_.Calc_Dt();
+
+    Calc_Iter(dt);
+
+    return dt;
+}
+
+/**
+ * \brief Iterations calculation until given physical time.
+ *
+ * Time step is calculated from CFL number,
+ * the last step is cut to finish exactly at given time.
+ *
+ * \param[in] t - final physical time
+ *
+ * \return
+ * Iterations count.
+ */
+template <class Riemann_Solver>
+int Godunov_2<Riemann_Solver>::Calc_Until(double t)
+{
+    int count = 0;
+    bool is_last = (G_p_->Time() >= t) || !Is_Storage_Supported();
+
+    while (!is_last)
+    {
+        double dt = Time_Step_.Calc_Dt();
+        double rest = t - G_p_->Time();
+
+        if (dt >= rest)
+        {
+            dt = rest;
+            is_last = true;
+        }
+
+        Calc_Iter(dt);
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * \brief Iteration calculation for single block.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Calc_Iter(Block *b_p,
+                                          double dt)
+{
+    // Scheme works with structure of arrays.
+    assert(b_p->Is_SoA());
+
+    Reconstruction *r_p = Get_Reconstruction(b_p);
+    Face_Flows *f_p = Get_Face_Flows(b_p);
+    Box region = b_p->Get_Box();
+    int tiles_count = Tiling_.Count(region);
+
+    // Slopes and half step states.
+    #pragma omp parallel for schedule(static, 1)
+    for (int t = 0; t < tiles_count; t++)
+    {
+        Calc_Tile_Predictor(b_p, r_p, Tiling_.Get(region, t), dt);
+    }
+
+    // Faces flows.
+    #pragma omp parallel for schedule(static, 1)
+    for (int t = 0; t < tiles_count; t++)
+    {
+        Calc_Tile_Flows(b_p, r_p, f_p, Tiling_.Get(region, t), dt);
+    }
+
+    // Cells update.
+    #pragma omp parallel for schedule(static, 1)
+    for (int t = 0; t < tiles_count; t++)
+    {
+        Calc_Tile_Cells(b_p, f_p, Tiling_.Get(region, t), dt);
+    }
+}
+
+/**
+ * \brief Limited slopes of array.
+ *
+ * \param[in] l - left neighbours values
+ * \param[in] c - cells values
+ * \param[in] r - right neighbours values
+ * \param[in] n - cells count
+ * \param[out] s - slopes
+ */
+template <double (*Slope)(double, double)>
+static inline void Slopes_Array(const double *l,
+                                const double *c,
+                                const double *r,
+                                int n,
+                                double *s)
+{
+    #pragma omp simd
+    for (int i = 0; i < n; i++)
+    {
+        s[i] = Slope(c[i] - l[i], r[i] - c[i]);
+    }
+}
+
+/**
+ * \brief Limited slopes of row of cells.
+ *
+ * Slopes of density, speed and pressure are calculated.
+ *
+ * \param[in] limiter - limiter
+ * \param[in] l - left neighbours states
+ * \param[in] c - cells states
+ * \param[in] r - right neighbours states
+ * \param[in] n - cells count
+ * \param[out] s - slopes
+ */
+static inline void Slopes_Row(int limiter,
+                              const Fluid_Dyn_Arrays &l,
+                              const Fluid_Dyn_Arrays &c,
+                              const Fluid_Dyn_Arrays &r,
+                              int n,
+                              const Fluid_Dyn_Arrays &s)
+{
+    double *ls[] = { l.R, l.VX, l.VY, l.VZ, l.P };
+    double *cs[] = { c.R, c.VX, c.VY, c.VZ, c.P };
+    double *rs[] = { r.R, r.VX, r.VY, r.VZ, r.P };
+    double *ss[] = { s.R, s.VX, s.VY, s.VZ, s.P };
+
+    for (int v = 0; v < 5; v++)
+    {
+        switch (limiter)
+        {
+            case Limiter::Minmod:
+                Slopes_Array<Limiter::Minmod_Slope>(ls[v], cs[v], rs[v], n, ss[v]);
+                break;
+
+            case Limiter::Van_Leer:
+                Slopes_Array<Limiter::Van_Leer_Slope>(ls[v], cs[v], rs[v], n, ss[v]);
+                break;
+
+            case Limiter::MC:
+                Slopes_Array<Limiter::MC_Slope>(ls[v], cs[v], rs[v], n, ss[v]);
+                break;
+
+            default:
+                assert(false);
+        }
+    }
+}
+
+/**
+ * \brief Hancock predictor for row of cells.
+ *
+ * Primitive variables are moved to the half of time step:
+ * W_half = W - dt / 2 * sum(A_d(W) * Slope_d / h_d),
+ * where h_d is cell size in direction d (volume divided by average face square).
+ *
+ * \param[in] u - cells states
+ * \param[in] si - slopes in I direction
+ * \param[in] sj - slopes in J direction
+ * \param[in] sk - slopes in K direction
+ * \param[in] vo - volumes
+ * \param[in] s - faces squares (for all directions)
+ * \param[in] n - cells count
+ * \param[in] dt - time step
+ * \param[out] h - half step states
+ */
+static inline void Predictor_Row(const Fluid_Dyn_Arrays &u,
+                                 const Fluid_Dyn_Arrays &si,
+                                 const Fluid_Dyn_Arrays &sj,
+                                 const Fluid_Dyn_Arrays &sk,
+                                 const double *vo,
+                                 const double * const *s,
+                                 int n,
+                                 double dt,
+                                 const Fluid_Dyn_Arrays &h)
+{
+    const double g = Fluid_Dyn_Pars::Gamma;
+    const double q = 0.25 * dt;
+
+    #pragma omp simd
+    for (int i = 0; i < n; i++)
+    {
+        double r = u.R[i];
+        double vx = u.VX[i];
+        double vy = u.VY[i];
+        double vz = u.VZ[i];
+        double p = u.P[i];
+        double a = q * (s[Direction::I0][i] + s[Direction::I1][i]) / vo[i];
+        double b = q * (s[Direction::J0][i] + s[Direction::J1][i]) / vo[i];
+        double c = q * (s[Direction::K0][i] + s[Direction::K1][i]) / vo[i];
+
+        h.R[i] = r - (a * (vx * si.R[i] + r * si.VX[i])
+                      + b * (vy * sj.R[i] + r * sj.VY[i])
+                      + c * (vz * sk.R[i] + r * sk.VZ[i]));
+        h.VX[i] = vx - (a * (vx * si.VX[i] + si.P[i] / r)
+                        + b * vy * sj.VX[i]
+                        + c * vz * sk.VX[i]);
+        h.VY[i] = vy - (a * vx * si.VY[i]
+                        + b * (vy * sj.VY[i] + sj.P[i] / r)
+                        + c * vz * sk.VY[i]);
+        h.VZ[i] = vz - (a * vx * si.VZ[i]
+                        + b * vy * sj.VZ[i]
+                        + c * (vz * sk.VZ[i] + sk.P[i] / r));
+        h.P[i] = p - (a * (g * p * si.VX[i] + vx * si.P[i])
+                      + b * (g * p * sj.VY[i] + vy * sj.P[i])
+                      + c * (g * p * sk.VZ[i] + vz * sk.P[i]));
+    }
+}
+
+/**
+ * \brief States on faces of row of cells.
+ *
+ * \param[in] h - half step states
+ * \param[in] sl - slopes
+ * \param[in] n - cells count
+ * \param[in] k - part of slope (-1/2 for negative faces, 1/2 for positive ones)
+ * \param[out] w - states on faces
+ */
+static inline void Extrapolate_Row(const Fluid_Dyn_Arrays &h,
+                                   const Fluid_Dyn_Arrays &sl,
+                                   int n,
+                                   double k,
+                                   const Fluid_Dyn_Arrays &w)
+{
+    const double g1 = Fluid_Dyn_Pars::Gamma - 1.0;
+
+    #pragma omp simd
+    for (int i = 0; i < n; i++)
+    {
+        w.R[i] = h.R[i] + k * sl.R[i];
+        w.VX[i] = h.VX[i] + k * sl.VX[i];
+        w.VY[i] = h.VY[i] + k * sl.VY[i];
+        w.VZ[i] = h.VZ[i] + k * sl.VZ[i];
+        w.P[i] = h.P[i] + k * sl.P[i];
+        w.E[i] = w.P[i] / (g1 * w.R[i]);
+    }
+}
+
+/**
+ * \brief Neighbours of shadow row behind edge of block.
+ *
+ * Shadow layers do not have edges, so neighbours of shadow cells behind tangent facet
+ * are made from the shadow cells themselves: they are reflected at hard border
+ * and copied (zero gradient) behind interfaces, where the flow continues.
+ *
+ * \param[in] b_p - block pointer
+ * \param[in] g - shadow cells states
+ * \param[in] n - cells count
+ * \param[in] e - tangent direction
+ * \param[in] i - i coordinate of block cell of the first shadow cell
+ * \param[in] j - j coordinate of block cell of the first shadow cell
+ * \param[in] k - k coordinate of block cell of the first shadow cell
+ * \param[out] w - neighbours states
+ */
+static inline void Edge_Row(const Block *b_p,
+                            const Fluid_Dyn_Arrays &g,
+                            int n,
+                            int e,
+                            int i,
+                            int j,
+                            int k,
+                            const Fluid_Dyn_Arrays &w)
+{
+    const Facet *f_p = b_p->Get_Facet(e);
+
+    for (int x = 0; x < n; x++)
+    {
+        int a, b;
+
+        Shadow::Tangents(e, i + x, j, k, a, b);
+
+        if (f_p->Is_Iface(a, b))
+        {
+            w.Shift(x).Copy(g.Shift(x), 1);
+        }
+        else
+        {
+            Row_Kernels::Reflect(g.Shift(x), 1, e, w.Shift(x));
+        }
+    }
+}
+
+/**
+ * \brief Slopes and half step states for tile.
+ *
+ * Cells behind the block border are taken from the first shadow layer.
+ *
+ * \param[in] b_p - block pointer
+ * \param[out] r_p - reconstruction
+ * \param[in] tile - tile
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Calc_Tile_Predictor(Block *b_p,
+                                                    Reconstruction *r_p,
+                                                    const Box &tile,
+                                                    double dt)
+{
+    int i_size = b_p->I_Size();
+    int j_size = b_p->J_Size();
+    int k_size = b_p->K_Size();
+    int ij_size = i_size * j_size;
+    int cur = b_p->Get_Grid()->Layer();
+    Cells_SoA *soa_p = b_p->SoA;
+    const Shadow *sh_p = b_p->Shadows;
+    int n = tile.I_Size();
+
+    // Neighbours rows (work memory of thread).
+    double *buf = Threads_Memory_.Get(12 * n);
+    Fluid_Dyn_Arrays wl, wr;
+    wl.Set_Memory(buf, n);
+    wr.Set_Memory(buf + 6 * n, n);
+
+    for (int k = tile.K0; k < tile.K1; k++)
+    {
+        for (int j = tile.J0; j < tile.J1; j++)
+        {
+            int c0 = b_p->Cell_Index(tile.I0, j, k);
+            const Fluid_Dyn_Arrays u = soa_p->U[cur].Shift(c0);
+            Fluid_Dyn_Arrays l, r;
+
+            // I (neighbours are copied since only border cells of row are shadow cells).
+            wl.Shift(1).Copy(u, n - 1);
+            if (tile.I0 == 0)
+            {
+                wl.Copy(sh_p->Row(Direction::I0, 0, 0, j, k), 1);
+            }
+            else
+            {
+                wl.Copy(u.Shift(-1), 1);
+            }
+            wr.Copy(u.Shift(1), n - 1);
+            if (tile.I1 == i_size)
+            {
+                wr.Shift(n - 1).Copy(sh_p->Row(Direction::I1, 0, 0, j, k), 1);
+            }
+            else
+            {
+                wr.Shift(n - 1).Copy(u.Shift(n), 1);
+            }
+            Slopes_Row(Limiter_, wl, u, wr, n, r_p->I.Shift(c0));
+
+            // J.
+            if (j == 0)
+            {
+                l = sh_p->Row(Direction::J0, 0, tile.I0, j, k);
+            }
+            else
+            {
+                l = u.Shift(-i_size);
+            }
+            if (j == j_size - 1)
+            {
+                r = sh_p->Row(Direction::J1, 0, tile.I0, j, k);
+            }
+            else
+            {
+                r = u.Shift(i_size);
+            }
+            Slopes_Row(Limiter_, l, u, r, n, r_p->J.Shift(c0));
+
+            // K.
+            if (k == 0)
+            {
+                l = sh_p->Row(Direction::K0, 0, tile.I0, j, k);
+            }
+            else
+            {
+                l = u.Shift(-ij_size);
+            }
+            if (k == k_size - 1)
+            {
+                r = sh_p->Row(Direction::K1, 0, tile.I0, j, k);
+            }
+            else
+            {
+                r = u.Shift(ij_size);
+            }
+            Slopes_Row(Limiter_, l, u, r, n, r_p->K.Shift(c0));
+
+            // Half step.
+            const double *s[Direction::Count];
+            for (int d = 0; d < Direction::Count; d++)
+            {
+                s[d] = soa_p->S[d] + c0;
+            }
+            Predictor_Row(u, r_p->I.Shift(c0), r_p->J.Shift(c0), r_p->K.Shift(c0),
+                          soa_p->Vo + c0, s, n, dt, r_p->Half.Shift(c0));
+        }
+    }
+}
+
+/**
+ * \brief Calculate faces flows for tile.
+ *
+ * Tile calculates flows through its negative faces,
+ * tiles on the positive block borders also calculate flows through the border faces
+ * (like in two phase scheme of Godunov_1).
+ * States on the both sides of face are reconstructed from half step states and slopes.
+ *
+ * \param[in] b_p - block pointer
+ * \param[in] r_p - reconstruction
+ * \param[out] f_p - faces flows
+ * \param[in] tile - tile
+ * \param[in] dt - time step (for half step states behind block borders)
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Calc_Tile_Flows(Block *b_p,
+                                                const Reconstruction *r_p,
+                                                Face_Flows *f_p,
+                                                const Box &tile,
+                                                double dt)
+{
+    int i_size = b_p->I_Size();
+    int ij_size = i_size * b_p->J_Size();
+    Cells_SoA *soa_p = b_p->SoA;
+    const Fluid_Dyn_Arrays &h = r_p->Half;
+    const double *s_i1 = soa_p->S[Direction::I1];
+    const double *s_j1 = soa_p->S[Direction::J1];
+    const double *s_k1 = soa_p->S[Direction::K1];
+    int n = tile.I_Size();
+
+    // States on the left and right sides of faces row (work memory of thread).
+    double *buf = Threads_Memory_.Get(12 * n);
+    Fluid_Dyn_Arrays wl, wr;
+    wl.Set_Memory(buf, n);
+    wr.Set_Memory(buf + 6 * n, n);
+
+    // Inner faces are faces with cells on both sides.
+    int i0 = (tile.I0 == 0) ? 1 : tile.I0;
+    int j0 = (tile.J0 == 0) ? 1 : tile.J0;
+    int k0 = (tile.K0 == 0) ? 1 : tile.K0;
+
+    // I inner faces.
+    for (int k = tile.K0; k < tile.K1; k++)
+    {
+        for (int j = tile.J0; j < tile.J1; j++)
+        {
+            int c = b_p->Cell_Index(i0, j, k);
+            int m = tile.I1 - i0;
+
+            Extrapolate_Row(h.Shift(c - 1), r_p->I.Shift(c - 1), m, 0.5, wl);
+            Extrapolate_Row(h.Shift(c), r_p->I.Shift(c), m, -0.5, wr);
+            Row_Kernels::Faces_Flows<Riemann_Solver>(wl, wr, s_i1 + c - 1, m, Direction::I0,
+                                                     f_p->I.Shift(f_p->I_Index(i0, j, k)));
+        }
+    }
+
+    // J inner faces.
+    for (int k = tile.K0; k < tile.K1; k++)
+    {
+        for (int j = j0; j < tile.J1; j++)
+        {
+            int c = b_p->Cell_Index(tile.I0, j, k);
+
+            Extrapolate_Row(h.Shift(c - i_size), r_p->J.Shift(c - i_size), n, 0.5, wl);
+            Extrapolate_Row(h.Shift(c), r_p->J.Shift(c), n, -0.5, wr);
+            Row_Kernels::Faces_Flows<Riemann_Solver>(wl, wr, s_j1 + c - i_size, n, Direction::J0,
+                                                     f_p->J.Shift(f_p->J_Index(tile.I0, j, k)));
+        }
+    }
+
+    // K inner faces.
+    for (int k = k0; k < tile.K1; k++)
+    {
+        for (int j = tile.J0; j < tile.J1; j++)
+        {
+            int c = b_p->Cell_Index(tile.I0, j, k);
+
+            Extrapolate_Row(h.Shift(c - ij_size), r_p->K.Shift(c - ij_size), n, 0.5, wl);
+            Extrapolate_Row(h.Shift(c), r_p->K.Shift(c), n, -0.5, wr);
+            Row_Kernels::Faces_Flows<Riemann_Solver>(wl, wr, s_k1 + c - ij_size, n, Direction::K0,
+                                                     f_p->K.Shift(f_p->K_Index(tile.I0, j, k)));
+        }
+    }
+
+    // Block borders.
+    for (int d = 0; d < Direction::Count; d++)
+    {
+        Calc_Tile_Border_Flows(b_p, r_p, f_p, tile, d, dt);
+    }
+}
+
+/**
+ * \brief Calculate flows through block border faces of tile in given direction.
+ *
+ * Nothing is done if tile does not touch the border.
+ * States behind the border are reconstructed from two shadow layers
+ * like states of block cells (volumes and faces squares of border cells are used,
+ * slopes along the border are limited by reflection at the edges of shadow layer).
+ *
+ * \param[in] b_p - block pointer
+ * \param[in] r_p - reconstruction
+ * \param[out] f_p - faces flows
+ * \param[in] tile - tile
+ * \param[in] d - direction of border
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Calc_Tile_Border_Flows(Block *b_p,
+                                                       const Reconstruction *r_p,
+                                                       Face_Flows *f_p,
+                                                       const Box &tile,
+                                                       int d,
+                                                       double dt)
+{
+    Box border;
+
+    // Tile does not touch the border.
+    if (!tile.Get_Border(b_p->Get_Box(), d, border))
+    {
+        return;
+    }
+
+    int cur = b_p->Get_Grid()->Layer();
+    Cells_SoA *soa_p = b_p->SoA;
+    const Shadow *sh_p = b_p->Shadows;
+    bool is_neg = Direction::Is_Negative(d);
+    int n = border.I_Size();
+
+    // Axes of normal and tangent directions (a is the fastest tangent index of shadow).
+    int axis = d / 2;
+    int axis_a = (axis == 0) ? 1 : 0;
+    int axis_b = (axis == 2) ? 1 : 2;
+    int a_size = sh_p->A_Size(d);
+    int b_size = sh_p->B_Size(d);
+
+    // Neighbours rows, slopes, half step states and states on faces (work memory of thread).
+    double *buf = Threads_Memory_.Get(48 * n);
+    Fluid_Dyn_Arrays wl, wr, sl[3], h, wg, wu;
+    wl.Set_Memory(buf, n);
+    wr.Set_Memory(buf + 6 * n, n);
+    for (int i = 0; i < 3; i++)
+    {
+        sl[i].Set_Memory(buf + (12 + 6 * i) * n, n);
+    }
+    h.Set_Memory(buf + 30 * n, n);
+    wg.Set_Memory(buf + 36 * n, n);
+    wu.Set_Memory(buf + 42 * n, n);
+
+    for (int k = border.K0; k < border.K1; k++)
+    {
+        for (int j = border.J0; j < border.J1; j++)
+        {
+            int c = b_p->Cell_Index(border.I0, j, k);
+            const Fluid_Dyn_Arrays u = soa_p->U[cur].Shift(c);
+            const Fluid_Dyn_Arrays g0 = sh_p->Row(d, 0, border.I0, j, k);
+            const Fluid_Dyn_Arrays g1 = sh_p->Row(d, 1, border.I0, j, k);
+            Fluid_Dyn_Arrays l, r;
+            int a, b;
+
+            Shadow::Tangents(d, border.I0, j, k, a, b);
+
+            // Normal direction (cells of block and the second shadow layer).
+            if (is_neg)
+            {
+                Slopes_Row(Limiter_, g1, g0, u, n, sl[axis]);
+            }
+            else
+            {
+                Slopes_Row(Limiter_, u, g0, g1, n, sl[axis]);
+            }
+
+            // Tangent direction a (neighbours are copied, edge cells are made by Edge_Row).
+            wl.Shift(1).Copy(g0, n - 1);
+            if (a == 0)
+            {
+                Edge_Row(b_p, g0, 1, 2 * axis_a, border.I0, j, k, wl);
+            }
+            else
+            {
+                wl.Copy(g0.Shift(-1), 1);
+            }
+            wr.Copy(g0.Shift(1), n - 1);
+            if (a + n == a_size)
+            {
+                Edge_Row(b_p, g0.Shift(n - 1), 1, 2 * axis_a + 1, border.I0 + n - 1, j, k,
+                         wr.Shift(n - 1));
+            }
+            else
+            {
+                wr.Shift(n - 1).Copy(g0.Shift(n), 1);
+            }
+            Slopes_Row(Limiter_, wl, g0, wr, n, sl[axis_a]);
+
+            // Tangent direction b.
+            if (b == 0)
+            {
+                Edge_Row(b_p, g0, n, 2 * axis_b, border.I0, j, k, wl);
+                l = wl;
+            }
+            else
+            {
+                l = g0.Shift(-a_size);
+            }
+            if (b == b_size - 1)
+            {
+                Edge_Row(b_p, g0, n, 2 * axis_b + 1, border.I0, j, k, wr);
+                r = wr;
+            }
+            else
+            {
+                r = g0.Shift(a_size);
+            }
+            Slopes_Row(Limiter_, l, g0, r, n, sl[axis_b]);
+
+            // Half step behind the border.
+            const double *s[Direction::Count];
+            for (int e = 0; e < Direction::Count; e++)
+            {
+                s[e] = soa_p->S[e] + c;
+            }
+            Predictor_Row(g0, sl[0], sl[1], sl[2], soa_p->Vo + c, s, n, dt, h);
+
+            // States on both sides of border faces.
+            Extrapolate_Row(h, sl[axis], n, is_neg ? 0.5 : -0.5, wg);
+            Extrapolate_Row(r_p->Half.Shift(c), r_p->Slopes(d).Shift(c), n,
+                            is_neg ? -0.5 : 0.5, wu);
+            Row_Kernels::Border_Flows<Riemann_Solver>(wu, wg, soa_p->S[d] + c, n, d,
+                                                      f_p->Cell_Face(d, border.I0, j, k));
+        }
+    }
+}
+
+/**
+ * \brief Update cells of tile by faces flows.
+ *
+ * \param[in,out] b_p - block pointer
+ * \param[in] f_p - faces flows
+ * \param[in] tile - tile
+ * \param[in] dt - time step
+ */
+template <class Riemann_Solver>
+void Godunov_2<Riemann_Solver>::Calc_Tile_Cells(Block *b_p,
+                                                const Face_Flows *f_p,
+                                                const Box &tile,
+                                                double dt)
+{
+    int i_size = b_p->I_Size();
+    int ij_size = i_size * b_p->J_Size();
+    int cur = b_p->Get_Grid()->Layer();
+    int nxt = cur ^ 1;
+    Cells_SoA *soa_p = b_p->SoA;
+
+    for (int k = tile.K0; k < tile.K1; k++)
+    {
+        for (int j = tile.J0; j < tile.J1; j++)
+        {
+            int c0 = b_p->Cell_Index(tile.I0, j, k);
+            const Fluid_Dyn_Arrays fi = f_p->I.Shift(f_p->I_Index(tile.I0, j, k));
+            const Fluid_Dyn_Arrays fj = f_p->J.Shift(f_p->J_Index(tile.I0, j, k));
+            const Fluid_Dyn_Arrays fk = f_p->K.Shift(f_p->K_Index(tile.I0, j, k));
+
+            Row_Kernels::Update(soa_p->U[cur].Shift(c0), soa_p->U[nxt].Shift(c0), soa_p->Vo + c0,
+                                tile.I_Size(), dt,
+                                fi, fi.Shift(1), fj, fj.Shift(i_size), fk, fk.Shift(ij_size));
+        }
+    }
+}
+
+/*
+ * Explicit instantiations (solvers policies).
+ */
+
+template class Godunov_2<Riemann_Avg>;
+template class Godunov_2<Riemann_HLL>;
+template class Godunov_2<Riemann_HLLC>;
+template class Godunov_2<Riemann_Roe>;
+
+} }
+
@@ -0,0 +1,130 @@
+/**
+ * \file
+ * \brief Godunov method order of accuracy 2 (MUSCL-Hancock).
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_GODUNOV_2_H
+#define HYDRO_SOLVER_GODUNOV_2_H
+
+#include "Grid/Grid.h"
+#include "Grid/Tiling.h"
+#include "Limiter.h"
+#include "Face_Flows.h"
+#include "Reconstruction.h"
+#include "Time_Step.h"
+#include "Riemann_HLLC.h"
+#include "Lib/OMP/omp.h"
+
+using namespace Hydro::Grid;
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Godunov method order of accuracy 2 (MUSCL-Hancock).
+ *
+ * Iteration for block has three phases (each is parallel over tiles):
+ * - limited slopes of density, speed and pressure and prediction of cells
+ *   states to the half of time step (Hancock predictor),
+ * - flows through faces by states reconstructed on both sides of faces,
+ * - cells update by faces flows (the same as in Godunov_1).
+ * Riemann solver is a policy (like in Godunov_1),
+ * class is instantiated for all solvers in Godunov_2.cpp.
+ * Grid must have structure of arrays storage, otherwise error is reported by constructor
+ * and iterations are not calculated.
+ */
+template <class Riemann_Solver = Riemann_HLLC>
+class Godunov_2
+{
+
+public:
+
+    // Constructors/destructors.
+    Godunov_2(Hydro::Grid::Grid *g_p);
+    ~Godunov_2();
+
+    // Limiter settings.
+    int Get_Limiter() const { return Limiter_; }
+    void Set_Limiter(int limiter) { Limiter_ = limiter; }
+
+    // Tiling settings.
+    const Tiling &Get_Tiling() const { return Tiling_; }
+    void Set_Tiles(int i_size,
+                   int j_size,
+                   int k_size) { Tiling_.Set_Sizes(i_size, j_size, k_size); }
+
+    // Time step settings.
+    double Get_CFL() const { return Time_Step_.Get_CFL(); }
+    void Set_CFL(double cfl) { Time_Step_.Set_CFL(cfl); }
+
+    // Iterations.
+    void Calc_Iters(int count,
+                    double dt);
+    void Calc_Iter(double dt);
+
+    // Iterations with time step from CFL number.
+    void Calc_Iters(int count);
+    double Calc_Iter();
+    int Calc_Until(double t);
+
+private:
+
+    // Grid.
+    Hydro::Grid::Grid *G_p_;
+
+    // Slope limiter.
+    int Limiter_;
+
+    // Time step control.
+    Time_Step Time_Step_;
+
+    // Tiling.
+    Tiling Tiling_;
+
+    // Work memory of threads (rows buffers of tiles).
+    Lib::OMP::Threads_Memory Threads_Memory_;
+
+    // Data of blocks (faces flows and reconstructions).
+    int Blocks_Data_Count_;
+    Face_Flows **Face_Flows_p_;
+    Reconstruction **Reconstructions_p_;
+
+    // Storage check.
+    bool Is_Storage_Supported() const { return G_p_->Storage() == Storage::SoA; }
+
+    // Data of blocks.
+    void Check_Blocks_Data();
+    Face_Flows *Get_Face_Flows(Block *b_p);
+    Reconstruction *Get_Reconstruction(Block *b_p);
+    void Free_Inactive_Blocks_Data();
+    void Deallocate_Blocks_Data();
+
+    // Iteration for block.
+    void Calc_Iter(Block *b_p,
+                   double dt);
+    void Calc_Tile_Predictor(Block *b_p,
+                             Reconstruction *r_p,
+                             const Box &tile,
+                             double dt);
+    void Calc_Tile_Flows(Block *b_p,
+                         const Reconstruction *r_p,
+                         Face_Flows *f_p,
+                         const Box &tile,
+                         double dt);
+    void Calc_Tile_Border_Flows(Block *b_p,
+                                const Reconstruction *r_p,
+                                Face_Flows *f_p,
+                                const Box &tile,
+                                int d,
+                                double dt);
+    void Calc_Tile_Cells(Block *b_p,
+                         const Face_Flows *f_p,
+                         const Box &tile,
+                         double dt);
+};
+
+} }
+
+#endif
+
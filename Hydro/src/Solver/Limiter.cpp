@@ -0,0 +1,39 @@
+/**
+ * \file
+ * \brief Slope limiter functions realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Limiter.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Name of limiter.
+ *
+ * \param[in] limiter - limiter
+ *
+ * \return
+ * Name of limiter.
+ */
+string Limiter::Name(int limiter)
+{
+    switch (limiter)
+    {
+        case Minmod:
+            return "Minmod";
+
+        case Van_Leer:
+            return "Van_Leer";
+
+        case MC:
+            return "MC";
+
+        default:
+            assert(false);
+    }
+}
+
+} }
+
@@ -0,0 +1,98 @@
+/**
+ * \file
+ * \brief Slope limiter.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_LIMITER_H
+#define HYDRO_SOLVER_LIMITER_H
+
+#include <cassert>
+#include <cmath>
+#include "Lib/IO/io.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Slope limiter.
+ *
+ * Limiter calculates slope of cell by left (a) and right (b) differences.
+ * All limiters give zero slope in extremum (a * b <= 0).
+ */
+class Limiter
+{
+
+public:
+
+    /**
+     * \brief Limiters enumeration.
+     */
+    enum
+    {
+        Minmod = 0,   /**< minimal by modulo difference (the most diffusive) */
+        Van_Leer = 1, /**< harmonic mean of differences */
+        MC = 2,       /**< monotonized central (the least diffusive) */
+        Count = 3     /**< count of limiters */
+    };
+
+    // Functions.
+    static string Name(int limiter);
+
+    /**
+     * \brief Minmod limiter.
+     *
+     * \param[in] a - left difference
+     * \param[in] b - right difference
+     *
+     * \return
+     * Slope.
+     */
+    static double Minmod_Slope(double a,
+                               double b)
+    {
+        return (a * b <= 0.0) ? 0.0 : ((fabs(a) < fabs(b)) ? a : b);
+    }
+
+    /**
+     * \brief Van Leer limiter.
+     *
+     * \param[in] a - left difference
+     * \param[in] b - right difference
+     *
+     * \return
+     * Slope.
+     */
+    static double Van_Leer_Slope(double a,
+                                 double b)
+    {
+        double ab = a * b;
+
+        return (ab <= 0.0) ? 0.0 : (2.0 * ab / (a + b));
+    }
+
+    /**
+     * \brief Monotonized central limiter.
+     *
+     * \param[in] a - left difference
+     * \param[in] b - right difference
+     *
+     * \return
+     * Slope.
+     */
+    static double MC_Slope(double a,
+                           double b)
+    {
+        double m = fmin(fmin(2.0 * fabs(a), 2.0 * fabs(b)), 0.5 * fabs(a + b));
+
+        return (a * b <= 0.0) ? 0.0 : ((a > 0.0) ? m : -m);
+    }
+
+private:
+
+};
+
+} }
+
+#endif
+
@@ -0,0 +1,140 @@
+/**
+ * \file
+ * \brief Linear reconstruction of block cells states realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Reconstruction.h"
+#include "Grid/Direction.h"
+#include <cassert>
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Count of arrays sets (slopes in I, J, K and half step states).
+ */
+#define HYDRO_SOLVER_RECONSTRUCTION_SETS 4
+
+/**
+ * \brief Count of arrays in set (R, VX, VY, VZ, E, P).
+ */
+#define HYDRO_SOLVER_RECONSTRUCTION_ARRAYS 6
+
+/*
+ * Constructors/destructors.
+ */
+
+/**
+ * \brief Constructor.
+ *
+ * \param[in] b_p - block
+ */
+Reconstruction::Reconstruction(Block *b_p)
+    : B_p_(b_p),
+      Memory_p_(NULL)
+{
+    Allocate_Memory();
+}
+
+/**
+ * \brief Default destructor.
+ */
+Reconstruction::~Reconstruction()
+{
+    Deallocate_Memory();
+}
+
+/*
+ * Simple data.
+ */
+
+/**
+ * \brief Get slopes in direction.
+ *
+ * \param[in] d - direction (both negative and positive directions give the same slopes)
+ *
+ * \return
+ * Slopes.
+ */
+const Fluid_Dyn_Arrays &Reconstruction::Slopes(int d) const
+{
+    switch (d)
+    {
+        case Direction::I0:
+        case Direction::I1:
+            return I;
+
+        case Direction::J0:
+        case Direction::J1:
+            return J;
+
+        case Direction::K0:
+        case Direction::K1:
+            return K;
+
+        default:
+            assert(false);
+
+            return I;
+    }
+}
+
+/**
+ * \brief Get bytes count.
+ *
+ * \return
+ * Bytes count.
+ */
+long Reconstruction::Bytes_Count() const
+{
+    long n = HYDRO_SOLVER_RECONSTRUCTION_SETS * HYDRO_SOLVER_RECONSTRUCTION_ARRAYS;
+
+    return n * B_p_->Cells_Count() * sizeof(double);
+}
+
+/*
+ * Allocate/deallocate memory.
+ */
+
+/**
+ * \brief Allocate memory.
+ *
+ * \return
+ * true - if memory is allocated,
+ * false - if memory is not allocated.
+ */
+bool Reconstruction::Allocate_Memory()
+{
+    int c = B_p_->Cells_Count();
+    int n = HYDRO_SOLVER_RECONSTRUCTION_ARRAYS * c;
+
+    Memory_p_ = new double[HYDRO_SOLVER_RECONSTRUCTION_SETS * n];
+
+    if (Memory_p_ == NULL)
+    {
+        return false;
+    }
+
+    I.Set_Memory(Memory_p_, c);
+    J.Set_Memory(Memory_p_ + n, c);
+    K.Set_Memory(Memory_p_ + 2 * n, c);
+    Half.Set_Memory(Memory_p_ + 3 * n, c);
+
+    return true;
+}
+
+/**
+ * \brief Deallocate memory.
+ */
+void Reconstruction::Deallocate_Memory()
+{
+    if (Memory_p_ != NULL)
+    {
+        delete [] Memory_p_;
+        Memory_p_ = NULL;
+    }
+}
+
+} }
+
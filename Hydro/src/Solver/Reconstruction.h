@@ -0,0 +1,63 @@
+/**
+ * \file
+ * \brief Linear reconstruction of block cells states.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_RECONSTRUCTION_H
+#define HYDRO_SOLVER_RECONSTRUCTION_H
+
+#include "Grid/Block.h"
+#include "Grid/Fluid_Dyn_Arrays.h"
+
+using namespace Hydro::Grid;
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Linear reconstruction of block cells states.
+ *
+ * For each cell there are limited slopes (differences per cell) of
+ * density, speed and pressure in I, J, K directions (E arrays are not used)
+ * and the state predicted to the half of time step.
+ * Arrays are linearized like cells of the block.
+ * State on the face of cell is Half +/- Slope / 2.
+ */
+class Reconstruction
+{
+
+public:
+
+    // Slopes in I, J, K directions.
+    Fluid_Dyn_Arrays I, J, K;
+
+    // States on half of time step.
+    Fluid_Dyn_Arrays Half;
+
+    // Constructors/destructors.
+    Reconstruction(Block *b_p);
+    ~Reconstruction();
+
+    // Simple data.
+    Block *B() const { return B_p_; }
+    const Fluid_Dyn_Arrays &Slopes(int d) const;
+    long Bytes_Count() const;
+
+private:
+
+    // Block.
+    Block *B_p_;
+
+    // Memory.
+    double *Memory_p_;
+
+    // Allocate/deallocate memory.
+    bool Allocate_Memory();
+    void Deallocate_Memory();
+};
+
+} }
+
+#endif
+
@@ -2,11 +2,19 @@
  * \file
  * \brief Riemann problem solver realization.
  *
+ * Batched functions have AVX-512 and AVX2 kernels and scalar fallback,
+ * kernel is selected at build time by target instruction set
+ * (for example -march=native).
+ *
  * \author Alexey Rybakov
  */
 
 #include "Riemann.h"
 
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace Hydro { namespace Solver {
 
 /**
@@ -24,5 +32,211 @@ void Riemann::Avg(const Fluid_Dyn_Pars *left_p,
     center_p->P = 0.5 * (left_p->P + right_p->P);
 }
 
+/**
+ * \brief Average of two arrays.
+ *
+ * \param[in] a - first array
+ * \param[in] b - second array
+ * \param[in] count - elements count
+ * \param[out] c - result array
+ */
+static void Avg_Array(const double *a,
+                      const double *b,
+                      int count,
+                      double *c)
+{
+    int i = 0;
+
+#if defined(__AVX512F__)
+    const __m512d h = _mm512_set1_pd(0.5);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d s = _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i));
+
+        _mm512_storeu_pd(c + i, _mm512_mul_pd(h, s));
+    }
+#elif defined(__AVX2__)
+    const __m256d h = _mm256_set1_pd(0.5);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d s = _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+
+        _mm256_storeu_pd(c + i, _mm256_mul_pd(h, s));
+    }
+#endif
+
+    // Tail (or the whole array for scalar kernel).
+    for (; i < count; i++)
+    {
+        c[i] = 0.5 * (a[i] + b[i]);
+    }
+}
+
+/**
+ * \brief Solve Riemann problems for array of faces by getting average values.
+ *
+ * \param[in] left - left states
+ * \param[in] right - right states
+ * \param[in] count - faces count
+ * \param[out] center - faces states
+ */
+void Riemann::Avg_Batch(const Fluid_Dyn_Arrays &left,
+                        const Fluid_Dyn_Arrays &right,
+                        int count,
+                        const Fluid_Dyn_Arrays &center)
+{
+    Avg_Array(left.R, right.R, count, center.R);
+    Avg_Array(left.VX, right.VX, count, center.VX);
+    Avg_Array(left.VY, right.VY, count, center.VY);
+    Avg_Array(left.VZ, right.VZ, count, center.VZ);
+    Avg_Array(left.E, right.E, count, center.E);
+    Avg_Array(left.P, right.P, count, center.P);
+}
+
+/**
+ * \brief Flows through array of faces by averaged states.
+ *
+ * Arrays are taken in face frame (normal velocity and normal momentum flow).
+ *
+ * \param[in] lr - left density
+ * \param[in] lv - left normal velocity
+ * \param[in] le - left energy
+ * \param[in] lp - left pressure
+ * \param[in] rr - right density
+ * \param[in] rv - right normal velocity
+ * \param[in] re - right energy
+ * \param[in] rp - right pressure
+ * \param[in] s - faces squares
+ * \param[in] count - faces count
+ * \param[out] fr - density flows
+ * \param[out] fv - normal momentum flows
+ * \param[out] fe - energy flows
+ */
+static void Avg_Flows_Kernel(const double *lr,
+                             const double *lv,
+                             const double *le,
+                             const double *lp,
+                             const double *rr,
+                             const double *rv,
+                             const double *re,
+                             const double *rp,
+                             const double *s,
+                             int count,
+                             double *fr,
+                             double *fv,
+                             double *fe)
+{
+    int i = 0;
+
+#if defined(__AVX512F__)
+    const __m512d h = _mm512_set1_pd(0.5);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d r = _mm512_mul_pd(h, _mm512_add_pd(_mm512_loadu_pd(lr + i),
+                                                   _mm512_loadu_pd(rr + i)));
+        __m512d v = _mm512_mul_pd(h, _mm512_add_pd(_mm512_loadu_pd(lv + i),
+                                                   _mm512_loadu_pd(rv + i)));
+        __m512d e = _mm512_mul_pd(h, _mm512_add_pd(_mm512_loadu_pd(le + i),
+                                                   _mm512_loadu_pd(re + i)));
+        __m512d p = _mm512_mul_pd(h, _mm512_add_pd(_mm512_loadu_pd(lp + i),
+                                                   _mm512_loadu_pd(rp + i)));
+        __m512d sq = _mm512_loadu_pd(s + i);
+        __m512d rv = _mm512_mul_pd(r, v);
+
+        _mm512_storeu_pd(fr + i, _mm512_mul_pd(rv, sq));
+        _mm512_storeu_pd(fv + i, _mm512_mul_pd(_mm512_add_pd(_mm512_mul_pd(rv, v), p), sq));
+        _mm512_storeu_pd(fe + i, _mm512_mul_pd(_mm512_mul_pd(_mm512_add_pd(e, p), v), sq));
+    }
+#elif defined(__AVX2__)
+    const __m256d h = _mm256_set1_pd(0.5);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256d r = _mm256_mul_pd(h, _mm256_add_pd(_mm256_loadu_pd(lr + i),
+                                                   _mm256_loadu_pd(rr + i)));
+        __m256d v = _mm256_mul_pd(h, _mm256_add_pd(_mm256_loadu_pd(lv + i),
+                                                   _mm256_loadu_pd(rv + i)));
+        __m256d e = _mm256_mul_pd(h, _mm256_add_pd(_mm256_loadu_pd(le + i),
+                                                   _mm256_loadu_pd(re + i)));
+        __m256d p = _mm256_mul_pd(h, _mm256_add_pd(_mm256_loadu_pd(lp + i),
+                                                   _mm256_loadu_pd(rp + i)));
+        __m256d sq = _mm256_loadu_pd(s + i);
+        __m256d rv = _mm256_mul_pd(r, v);
+
+        _mm256_storeu_pd(fr + i, _mm256_mul_pd(rv, sq));
+        _mm256_storeu_pd(fv + i, _mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(rv, v), p), sq));
+        _mm256_storeu_pd(fe + i, _mm256_mul_pd(_mm256_mul_pd(_mm256_add_pd(e, p), v), sq));
+    }
+#endif
+
+    // Tail (or the whole array for scalar kernel).
+    for (; i < count; i++)
+    {
+        double r = 0.5 * (lr[i] + rr[i]);
+        double v = 0.5 * (lv[i] + rv[i]);
+        double e = 0.5 * (le[i] + re[i]);
+        double p = 0.5 * (lp[i] + rp[i]);
+
+        fr[i] = r * v * s[i];
+        fv[i] = (r * v * v + p) * s[i];
+        fe[i] = (e + p) * v * s[i];
+    }
+}
+
+/**
+ * \brief Flows through array of faces (average values Riemann solver).
+ *
+ * Flows are calculated in positive direction and multiplied by faces squares,
+ * only normal momentum flow is not zero.
+ *
+ * \param[in] left - left states
+ * \param[in] right - right states
+ * \param[in] s - faces squares
+ * \param[in] count - faces count
+ * \param[in] d - direction
+ * \param[out] flows - flows
+ */
+void Riemann::Avg_Flows_Batch(const Fluid_Dyn_Arrays &left,
+                              const Fluid_Dyn_Arrays &right,
+                              const double *s,
+                              int count,
+                              int d,
+                              const Fluid_Dyn_Arrays &flows)
+{
+    const Fluid_Dyn_Arrays l = left.Rotate(d);
+    const Fluid_Dyn_Arrays r = right.Rotate(d);
+    const Fluid_Dyn_Arrays f = flows.Rotate(d);
+
+    Avg_Flows_Kernel(l.R, l.VX, l.E, l.P,
+                     r.R, r.VX, r.E, r.P,
+                     s, count, f.R, f.VX, f.E);
+
+    for (int i = 0; i < count; i++)
+    {
+        f.VY[i] = 0.0;
+        f.VZ[i] = 0.0;
+    }
+}
+
+/**
+ * \brief Name of batched kernels instruction set.
+ *
+ * \return
+ * Name of instruction set.
+ */
+string Riemann::Kernel_Name()
+{
+#if defined(__AVX512F__)
+    return "AVX-512";
+#elif defined(__AVX2__)
+    return "AVX2";
+#else
+    return "Scalar";
+#endif
+}
+
 } }
 
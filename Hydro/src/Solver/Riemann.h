@@ -9,6 +9,8 @@
 #define HYDRO_SOLVER_RIEMANN_H
 
 #include "Grid/Fluid_Dyn_Pars.h"
+#include "Grid/Fluid_Dyn_Arrays.h"
+#include "Lib/IO/io.h"
 
 using namespace Hydro::Grid;
 
@@ -27,6 +29,21 @@ public:
                     const Fluid_Dyn_Pars *right_p,
                     Fluid_Dyn_Pars *center_p);
 
+    // Batched versions (arrays of faces).
+    static void Avg_Batch(const Fluid_Dyn_Arrays &left,
+                          const Fluid_Dyn_Arrays &right,
+                          int count,
+                          const Fluid_Dyn_Arrays &center);
+    static void Avg_Flows_Batch(const Fluid_Dyn_Arrays &left,
+                                const Fluid_Dyn_Arrays &right,
+                                const double *s,
+                                int count,
+                                int d,
+                                const Fluid_Dyn_Arrays &flows);
+
+    // Name of batched kernels instruction set.
+    static string Kernel_Name();
+
 private:
 
 };
@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief Riemann solver by average values realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Riemann_Avg.h"
+#include "Riemann.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Name of solver.
+ *
+ * \return
+ * Name of solver.
+ */
+string Riemann_Avg::Name()
+{
+    return "Avg";
+}
+
+/**
+ * \brief Flows through array of faces.
+ *
+ * Flows are calculated in positive direction and multiplied by faces squares.
+ *
+ * \param[in] left - left states
+ * \param[in] right - right states
+ * \param[in] s - faces squares
+ * \param[in] count - faces count
+ * \param[in] d - direction
+ * \param[out] flows - flows
+ */
+void Riemann_Avg::Flows_Batch(const Fluid_Dyn_Arrays &left,
+                              const Fluid_Dyn_Arrays &right,
+                              const double *s,
+                              int count,
+                              int d,
+                              const Fluid_Dyn_Arrays &flows)
+{
+    Riemann::Avg_Flows_Batch(left, right, s, count, d, flows);
+}
+
+} }
+
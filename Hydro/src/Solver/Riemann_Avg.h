@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief Riemann solver by average values (policy for Godunov_1).
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_RIEMANN_AVG_H
+#define HYDRO_SOLVER_RIEMANN_AVG_H
+
+#include "Grid/Fluid_Dyn_Arrays.h"
+#include "Lib/IO/io.h"
+
+using namespace Hydro::Grid;
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Riemann solver by average values (policy for Godunov_1).
+ *
+ * Flows are calculated by averaged state, only normal momentum flow is not zero.
+ * It is original solver of the method, it is used as reference.
+ */
+class Riemann_Avg
+{
+
+public:
+
+    // Name of solver.
+    static string Name();
+
+    // Flows through array of faces.
+    static void Flows_Batch(const Fluid_Dyn_Arrays &left,
+                            const Fluid_Dyn_Arrays &right,
+                            const double *s,
+                            int count,
+                            int d,
+                            const Fluid_Dyn_Arrays &flows);
+
+private:
+
+};
+
+} }
+
+#endif
+
@@ -0,0 +1,78 @@
+/**
+ * \file
+ * \brief HLL approximate Riemann solver realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Riemann_HLL.h"
+#include <cmath>
+#include <algorithm>
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Name of solver.
+ *
+ * \return
+ * Name of solver.
+ */
+string Riemann_HLL::Name()
+{
+    return "HLL";
+}
+
+/**
+ * \brief Flows through array of faces.
+ *
+ * Flows are calculated in positive direction and multiplied by faces squares.
+ * States are in normal form, flows are flows of expand form (conservative variables).
+ * Loop body has no branches (waves speeds are clipped by zero),
+ * so it is vectorized.
+ *
+ * \param[in] left - left states
+ * \param[in] right - right states
+ * \param[in] s - faces squares
+ * \param[in] count - faces count
+ * \param[in] d - direction
+ * \param[out] flows - flows
+ */
+void Riemann_HLL::Flows_Batch(const Fluid_Dyn_Arrays &left,
+                              const Fluid_Dyn_Arrays &right,
+                              const double *s,
+                              int count,
+                              int d,
+                              const Fluid_Dyn_Arrays &flows)
+{
+    const Fluid_Dyn_Arrays l = left.Rotate(d);
+    const Fluid_Dyn_Arrays r = right.Rotate(d);
+    const Fluid_Dyn_Arrays f = flows.Rotate(d);
+    const double g = Fluid_Dyn_Pars::Gamma;
+
+    #pragma omp simd
+    for (int i = 0; i < count; i++)
+    {
+        double rl = l.R[i], ul = l.VX[i], vl = l.VY[i], wl = l.VZ[i], pl = l.P[i];
+        double rr = r.R[i], ur = r.VX[i], vr = r.VY[i], wr = r.VZ[i], pr = r.P[i];
+        double el = rl * (l.E[i] + 0.5 * (ul * ul + vl * vl + wl * wl));
+        double er = rr * (r.E[i] + 0.5 * (ur * ur + vr * vr + wr * wr));
+        double cl = sqrt(g * pl / rl);
+        double cr = sqrt(g * pr / rr);
+
+        // Waves speeds clipped by zero: supersonic cases give upwind flow.
+        double sl = std::min(std::min(ul - cl, ur - cr), 0.0);
+        double sr = std::max(std::max(ul + cl, ur + cr), 0.0);
+        double k = s[i] / (sr - sl);
+        double slr = sl * sr;
+
+        f.R[i] = k * (sr * rl * ul - sl * rr * ur + slr * (rr - rl));
+        f.VX[i] = k * (sr * (rl * ul * ul + pl) - sl * (rr * ur * ur + pr)
+                       + slr * (rr * ur - rl * ul));
+        f.VY[i] = k * (sr * rl * ul * vl - sl * rr * ur * vr + slr * (rr * vr - rl * vl));
+        f.VZ[i] = k * (sr * rl * ul * wl - sl * rr * ur * wr + slr * (rr * wr - rl * wl));
+        f.E[i] = k * (sr * (el + pl) * ul - sl * (er + pr) * ur + slr * (er - el));
+    }
+}
+
+} }
+
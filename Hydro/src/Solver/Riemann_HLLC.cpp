@@ -0,0 +1,101 @@
+/**
+ * \file
+ * \brief HLLC approximate Riemann solver realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Riemann_HLLC.h"
+#include <cmath>
+#include <algorithm>
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Name of solver.
+ *
+ * \return
+ * Name of solver.
+ */
+string Riemann_HLLC::Name()
+{
+    return "HLLC";
+}
+
+/**
+ * \brief Flows through array of faces.
+ *
+ * Flows are calculated in positive direction and multiplied by faces squares.
+ * States are in normal form, flows are flows of expand form (conservative variables).
+ * Side of contact wave is chosen by selects (not branches) and
+ * outer wave speed is clipped by zero, so loop body is vectorized:
+ * F = F_K + S_K * (U*_K - U_K), where K is the side of face and S_K = 0 for supersonic case.
+ *
+ * \param[in] left - left states
+ * \param[in] right - right states
+ * \param[in] s - faces squares
+ * \param[in] count - faces count
+ * \param[in] d - direction
+ * \param[out] flows - flows
+ */
+void Riemann_HLLC::Flows_Batch(const Fluid_Dyn_Arrays &left,
+                               const Fluid_Dyn_Arrays &right,
+                               const double *s,
+                               int count,
+                               int d,
+                               const Fluid_Dyn_Arrays &flows)
+{
+    const Fluid_Dyn_Arrays l = left.Rotate(d);
+    const Fluid_Dyn_Arrays r = right.Rotate(d);
+    const Fluid_Dyn_Arrays f = flows.Rotate(d);
+    const double g = Fluid_Dyn_Pars::Gamma;
+
+    #pragma omp simd
+    for (int i = 0; i < count; i++)
+    {
+        double rl = l.R[i], ul = l.VX[i], vl = l.VY[i], wl = l.VZ[i], pl = l.P[i];
+        double rr = r.R[i], ur = r.VX[i], vr = r.VY[i], wr = r.VZ[i], pr = r.P[i];
+        double el = rl * (l.E[i] + 0.5 * (ul * ul + vl * vl + wl * wl));
+        double er = rr * (r.E[i] + 0.5 * (ur * ur + vr * vr + wr * wr));
+        double cl = sqrt(g * pl / rl);
+        double cr = sqrt(g * pr / rr);
+        double sl = std::min(ul - cl, ur - cr);
+        double sr = std::max(ul + cl, ur + cr);
+
+        // Contact wave speed.
+        double ml = rl * (sl - ul);
+        double mr = rr * (sr - ur);
+        double ss = (pr - pl + ul * ml - ur * mr) / (ml - mr);
+
+        // Side of face.
+        bool is_l = (ss >= 0.0);
+        double rk = is_l ? rl : rr;
+        double uk = is_l ? ul : ur;
+        double vk = is_l ? vl : vr;
+        double wk = is_l ? wl : wr;
+        double pk = is_l ? pl : pr;
+        double ek = is_l ? el : er;
+        double sk = is_l ? sl : sr;
+        double mk = is_l ? ml : mr;
+        double sk0 = is_l ? std::min(sl, 0.0) : std::max(sr, 0.0);
+
+        // Star state.
+        double rs = mk / (sk - ss);
+        double es = rs * (ek / rk + (ss - uk) * (ss + pk / mk));
+
+        double fr = rk * uk;
+        double fu = fr * uk + pk;
+        double fv = fr * vk;
+        double fw = fr * wk;
+        double fe = (ek + pk) * uk;
+
+        f.R[i] = s[i] * (fr + sk0 * (rs - rk));
+        f.VX[i] = s[i] * (fu + sk0 * (rs * ss - fr));
+        f.VY[i] = s[i] * (fv + sk0 * (rs - rk) * vk);
+        f.VZ[i] = s[i] * (fw + sk0 * (rs - rk) * wk);
+        f.E[i] = s[i] * (fe + sk0 * (es - ek));
+    }
+}
+
+} }
+
@@ -0,0 +1,47 @@
+/**
+ * \file
+ * \brief HLLC approximate Riemann solver (policy for Godunov_1).
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_RIEMANN_HLLC_H
+#define HYDRO_SOLVER_RIEMANN_HLLC_H
+
+#include "Grid/Fluid_Dyn_Arrays.h"
+#include "Lib/IO/io.h"
+
+using namespace Hydro::Grid;
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief HLLC approximate Riemann solver (policy for Godunov_1).
+ *
+ * HLL solver with restored contact wave (Toro),
+ * waves speeds are estimated by Davis (min/max of u -/+ c of both states).
+ */
+class Riemann_HLLC
+{
+
+public:
+
+    // Name of solver.
+    static string Name();
+
+    // Flows through array of faces.
+    static void Flows_Batch(const Fluid_Dyn_Arrays &left,
+                            const Fluid_Dyn_Arrays &right,
+                            const double *s,
+                            int count,
+                            int d,
+                            const Fluid_Dyn_Arrays &flows);
+
+private:
+
+};
+
+} }
+
+#endif
+
@@ -0,0 +1,114 @@
+/**
+ * \file
+ * \brief Roe approximate Riemann solver realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Riemann_Roe.h"
+#include <cmath>
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Name of solver.
+ *
+ * \return
+ * Name of solver.
+ */
+string Riemann_Roe::Name()
+{
+    return "Roe";
+}
+
+/**
+ * \brief Flows through array of faces.
+ *
+ * Flows are calculated in positive direction and multiplied by faces squares.
+ * States are in normal form, flows are flows of expand form (conservative variables).
+ * F = (F_L + F_R) / 2 - sum(|lambda_k| * alpha_k * K_k) / 2 (Toro, Euler equations in 3D).
+ *
+ * \param[in] left - left states
+ * \param[in] right - right states
+ * \param[in] s - faces squares
+ * \param[in] count - faces count
+ * \param[in] d - direction
+ * \param[out] flows - flows
+ */
+void Riemann_Roe::Flows_Batch(const Fluid_Dyn_Arrays &left,
+                              const Fluid_Dyn_Arrays &right,
+                              const double *s,
+                              int count,
+                              int d,
+                              const Fluid_Dyn_Arrays &flows)
+{
+    const Fluid_Dyn_Arrays l = left.Rotate(d);
+    const Fluid_Dyn_Arrays r = right.Rotate(d);
+    const Fluid_Dyn_Arrays f = flows.Rotate(d);
+    const double g1 = Fluid_Dyn_Pars::Gamma - 1.0;
+
+    // Harten entropy fix width (part of sound speed).
+    const double fix = 0.1;
+
+    #pragma omp simd
+    for (int i = 0; i < count; i++)
+    {
+        double rl = l.R[i], ul = l.VX[i], vl = l.VY[i], wl = l.VZ[i], pl = l.P[i];
+        double rr = r.R[i], ur = r.VX[i], vr = r.VY[i], wr = r.VZ[i], pr = r.P[i];
+        double el = rl * (l.E[i] + 0.5 * (ul * ul + vl * vl + wl * wl));
+        double er = rr * (r.E[i] + 0.5 * (ur * ur + vr * vr + wr * wr));
+
+        // Roe averages.
+        double ql = sqrt(rl);
+        double qr = sqrt(rr);
+        double q = 1.0 / (ql + qr);
+        double u = (ql * ul + qr * ur) * q;
+        double v = (ql * vl + qr * vr) * q;
+        double w = (ql * wl + qr * wr) * q;
+        double h = (ql * (el + pl) / rl + qr * (er + pr) / rr) * q;
+        double v2 = 0.5 * (u * u + v * v + w * w);
+        double a = sqrt(g1 * (h - v2));
+
+        // Waves strengths.
+        double d1 = rr - rl;
+        double d2 = rr * ur - rl * ul;
+        double d3 = rr * vr - rl * vl;
+        double d4 = rr * wr - rl * wl;
+        double d5 = er - el;
+        double a3 = d3 - v * d1;
+        double a4 = d4 - w * d1;
+        double a2 = g1 / (a * a) * (d1 * (h - u * u) + u * d2 - (d5 - a3 * v - a4 * w));
+        double a1 = (d1 * (u + a) - d2 - a * a2) / (2.0 * a);
+        double a5 = d1 - (a1 + a2);
+
+        // Waves speeds (acoustic ones with entropy fix).
+        double de = fix * a;
+        double l1 = fabs(u - a);
+        double l2 = fabs(u);
+        double l5 = fabs(u + a);
+        l1 = (l1 < de) ? (0.5 * (l1 * l1 + de * de) / de) : l1;
+        l5 = (l5 < de) ? (0.5 * (l5 * l5 + de * de) / de) : l5;
+
+        // Dissipation.
+        double b1 = l1 * a1;
+        double b2 = l2 * a2;
+        double b5 = l5 * a5;
+        double b = b1 + b2 + b5;
+        double x1 = b;
+        double x2 = b1 * (u - a) + b2 * u + b5 * (u + a);
+        double x3 = b * v + l2 * a3;
+        double x4 = b * w + l2 * a4;
+        double x5 = b1 * (h - u * a) + b2 * v2 + l2 * (a3 * v + a4 * w) + b5 * (h + u * a);
+
+        double hs = 0.5 * s[i];
+
+        f.R[i] = hs * (rl * ul + rr * ur - x1);
+        f.VX[i] = hs * (rl * ul * ul + pl + rr * ur * ur + pr - x2);
+        f.VY[i] = hs * (rl * ul * vl + rr * ur * vr - x3);
+        f.VZ[i] = hs * (rl * ul * wl + rr * ur * wr - x4);
+        f.E[i] = hs * ((el + pl) * ul + (er + pr) * ur - x5);
+    }
+}
+
+} }
+
@@ -0,0 +1,46 @@
+/**
+ * \file
+ * \brief Roe approximate Riemann solver (policy for Godunov_1).
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_RIEMANN_ROE_H
+#define HYDRO_SOLVER_RIEMANN_ROE_H
+
+#include "Grid/Fluid_Dyn_Arrays.h"
+#include "Lib/IO/io.h"
+
+using namespace Hydro::Grid;
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Roe approximate Riemann solver (policy for Godunov_1).
+ *
+ * Linearized solver by Roe averaged state with Harten entropy fix for acoustic waves.
+ */
+class Riemann_Roe
+{
+
+public:
+
+    // Name of solver.
+    static string Name();
+
+    // Flows through array of faces.
+    static void Flows_Batch(const Fluid_Dyn_Arrays &left,
+                            const Fluid_Dyn_Arrays &right,
+                            const double *s,
+                            int count,
+                            int d,
+                            const Fluid_Dyn_Arrays &flows);
+
+private:
+
+};
+
+} }
+
+#endif
+
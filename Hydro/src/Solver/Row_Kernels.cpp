@@ -0,0 +1,143 @@
+/**
+ * \file
+ * \brief Kernels for rows of cells and faces realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include <cmath>
+#include "Row_Kernels.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Reflected states (normal speed changes its sign).
+ *
+ * \param[in] u - states
+ * \param[in] n - states count
+ * \param[in] d - direction of reflection plane normal
+ * \param[out] w - reflected states
+ */
+void Row_Kernels::Reflect(const Fluid_Dyn_Arrays &u,
+                          int n,
+                          int d,
+                          Fluid_Dyn_Arrays w)
+{
+    const double *un = u.Rotate(d).VX;
+    double *wn = w.Rotate(d).VX;
+
+    w.Copy(u, n);
+    for (int i = 0; i < n; i++)
+    {
+        wn[i] = -un[i];
+    }
+}
+
+/**
+ * \brief Update row of cells by flows through their faces.
+ *
+ * Next layer is calculated from current one:
+ * state is moved to expand form, takes flows through all six faces
+ * and is moved back to normal form.
+ * All arrays are shifted to the first cell of row (face before the first cell).
+ *
+ * \param[in] uc - current layer
+ * \param[out] un - next layer
+ * \param[in] vo - volumes
+ * \param[in] n - cells count
+ * \param[in] dt - time step
+ * \param[in] fi0 - flows through I0 faces
+ * \param[in] fi1 - flows through I1 faces
+ * \param[in] fj0 - flows through J0 faces
+ * \param[in] fj1 - flows through J1 faces
+ * \param[in] fk0 - flows through K0 faces
+ * \param[in] fk1 - flows through K1 faces
+ */
+void Row_Kernels::Update(const Fluid_Dyn_Arrays &uc,
+                         const Fluid_Dyn_Arrays &un,
+                         const double *vo,
+                         int n,
+                         double dt,
+                         const Fluid_Dyn_Arrays &fi0,
+                         const Fluid_Dyn_Arrays &fi1,
+                         const Fluid_Dyn_Arrays &fj0,
+                         const Fluid_Dyn_Arrays &fj1,
+                         const Fluid_Dyn_Arrays &fk0,
+                         const Fluid_Dyn_Arrays &fk1)
+{
+    const double g1 = Fluid_Dyn_Pars::Gamma - 1.0;
+
+    for (int i = 0; i < n; i++)
+    {
+        double d = dt / vo[i];
+        double r = uc.R[i];
+        double vx = uc.VX[i];
+        double vy = uc.VY[i];
+        double vz = uc.VZ[i];
+
+        // Expand form.
+        double e = r * (uc.E[i] + 0.5 * (vx * vx + vy * vy + vz * vz));
+        double mx = r * vx;
+        double my = r * vy;
+        double mz = r * vz;
+
+        // Flows.
+        r -= d * ((fi1.R[i] - fi0.R[i]) + (fj1.R[i] - fj0.R[i]) + (fk1.R[i] - fk0.R[i]));
+        mx -= d * ((fi1.VX[i] - fi0.VX[i]) + (fj1.VX[i] - fj0.VX[i]) + (fk1.VX[i] - fk0.VX[i]));
+        my -= d * ((fi1.VY[i] - fi0.VY[i]) + (fj1.VY[i] - fj0.VY[i]) + (fk1.VY[i] - fk0.VY[i]));
+        mz -= d * ((fi1.VZ[i] - fi0.VZ[i]) + (fj1.VZ[i] - fj0.VZ[i]) + (fk1.VZ[i] - fk0.VZ[i]));
+        e -= d * ((fi1.E[i] - fi0.E[i]) + (fj1.E[i] - fj0.E[i]) + (fk1.E[i] - fk0.E[i]));
+
+        // Normal form.
+        vx = mx / r;
+        vy = my / r;
+        vz = mz / r;
+        e = e / r - 0.5 * (vx * vx + vy * vy + vz * vz);
+        un.R[i] = r;
+        un.VX[i] = vx;
+        un.VY[i] = vy;
+        un.VZ[i] = vz;
+        un.E[i] = e;
+        un.P[i] = g1 * r * e;
+    }
+}
+
+/**
+ * \brief Maximum signal rate of row of cells.
+ *
+ * Signal rate of cell is sum over directions of (|v_d| + c) / h_d,
+ * where h_d is cell size in direction d (volume divided by average face square),
+ * so explicit time step is stable for dt * rate <= CFL.
+ *
+ * \param[in] u - cells states
+ * \param[in] vo - volumes
+ * \param[in] s - faces squares (for all directions)
+ * \param[in] n - cells count
+ *
+ * \return
+ * Maximum signal rate.
+ */
+double Row_Kernels::Max_Signal_Rate(const Fluid_Dyn_Arrays &u,
+                                    const double *vo,
+                                    const double * const *s,
+                                    int n)
+{
+    const double g = Fluid_Dyn_Pars::Gamma;
+    double rate = 0.0;
+
+    #pragma omp simd reduction(max:rate)
+    for (int i = 0; i < n; i++)
+    {
+        double c = sqrt(g * u.P[i] / u.R[i]);
+        double ri = (fabs(u.VX[i]) + c) * (s[Direction::I0][i] + s[Direction::I1][i]);
+        double rj = (fabs(u.VY[i]) + c) * (s[Direction::J0][i] + s[Direction::J1][i]);
+        double rk = (fabs(u.VZ[i]) + c) * (s[Direction::K0][i] + s[Direction::K1][i]);
+        double r = 0.5 * (ri + rj + rk) / vo[i];
+
+        rate = (r > rate) ? r : rate;
+    }
+
+    return rate;
+}
+
+} }
@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \brief Kernels for rows of cells and faces.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_ROW_KERNELS_H
+#define HYDRO_SOLVER_ROW_KERNELS_H
+
+#include "Grid/Fluid_Dyn_Arrays.h"
+#include "Grid/Direction.h"
+
+using namespace Hydro::Grid;
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Kernels for rows of cells and faces.
+ *
+ * Row is a set of contiguous elements (cells or faces along I direction),
+ * all arrays are shifted to the first element of row.
+ * Kernels are shared by Godunov solvers of all orders.
+ */
+class Row_Kernels
+{
+
+public:
+
+    /**
+     * \brief Calculate flows through row of faces.
+     *
+     * Riemann problems of row are solved by one batched call.
+     *
+     * \param[in] l - left states
+     * \param[in] r - right states
+     * \param[in] s - faces squares
+     * \param[in] n - faces count
+     * \param[in] d - direction of faces
+     * \param[out] f - flows
+     */
+    template <class Riemann_Solver>
+    static void Faces_Flows(const Fluid_Dyn_Arrays &l,
+                            const Fluid_Dyn_Arrays &r,
+                            const double *s,
+                            int n,
+                            int d,
+                            const Fluid_Dyn_Arrays &f)
+    {
+        Riemann_Solver::Flows_Batch(l, r, s, n, d, f);
+    }
+
+    /**
+     * \brief Calculate flows through row of block border faces.
+     *
+     * States behind the border are taken from shadow layer of block
+     * (neighbour block cells or reflected cells for hard border),
+     * they are placed before the cells for negative direction and after them for positive one.
+     *
+     * \param[in] u - states near border
+     * \param[in] g - states behind border
+     * \param[in] s - faces squares
+     * \param[in] n - faces count
+     * \param[in] d - direction of faces
+     * \param[out] f - flows
+     */
+    template <class Riemann_Solver>
+    static void Border_Flows(const Fluid_Dyn_Arrays &u,
+                             const Fluid_Dyn_Arrays &g,
+                             const double *s,
+                             int n,
+                             int d,
+                             const Fluid_Dyn_Arrays &f)
+    {
+        if (Direction::Is_Negative(d))
+        {
+            Riemann_Solver::Flows_Batch(g, u, s, n, d, f);
+        }
+        else
+        {
+            Riemann_Solver::Flows_Batch(u, g, s, n, d, f);
+        }
+    }
+
+    // Reflected states.
+    static void Reflect(const Fluid_Dyn_Arrays &u,
+                        int n,
+                        int d,
+                        Fluid_Dyn_Arrays w);
+
+    // Update cells by faces flows.
+    static void Update(const Fluid_Dyn_Arrays &uc,
+                       const Fluid_Dyn_Arrays &un,
+                       const double *vo,
+                       int n,
+                       double dt,
+                       const Fluid_Dyn_Arrays &fi0,
+                       const Fluid_Dyn_Arrays &fi1,
+                       const Fluid_Dyn_Arrays &fj0,
+                       const Fluid_Dyn_Arrays &fj1,
+                       const Fluid_Dyn_Arrays &fk0,
+                       const Fluid_Dyn_Arrays &fk1);
+
+    // Maximum signal rate of cells.
+    static double Max_Signal_Rate(const Fluid_Dyn_Arrays &u,
+                                  const double *vo,
+                                  const double * const *s,
+                                  int n);
+
+private:
+
+};
+
+} }
+
+#endif
+
@@ -0,0 +1,41 @@
+/**
+ * \file
+ * \brief Schedule of blocks calculation functions realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Schedule.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Name of schedule.
+ *
+ * \param[in] schedule - schedule
+ *
+ * \return
+ * Name of schedule.
+ */
+string Schedule::Name(int schedule)
+{
+    switch (schedule)
+    {
+        case Blocks:
+            return "Blocks";
+
+        case Tasks:
+            return "Tasks";
+
+        case Overlap:
+            return "Overlap";
+
+        case Progress:
+            return "Progress";
+
+        default:
+            assert(false);
+    }
+}
+
+} }
@@ -0,0 +1,45 @@
+/**
+ * \file
+ * \brief Schedule of blocks calculation between threads.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_SCHEDULE_H
+#define HYDRO_SOLVER_SCHEDULE_H
+
+#include <cassert>
+#include "Lib/IO/io.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Schedule of blocks calculation between threads.
+ */
+class Schedule
+{
+
+public:
+
+    /**
+     * \brief Schedules enumeration.
+     */
+    enum
+    {
+        Blocks = 0,  /**< blocks one by one, parallel loop over tiles of each block */
+        Tasks = 1,   /**< tiles of all blocks are tasks of one parallel region */
+        Overlap = 2,  /**< inner cells of blocks are calculated during shadows exchange */
+        Progress = 3, /**< overlap with one thread driving shadows exchange */
+        Count = 4     /**< count of schedules */
+    };
+
+    // Functions.
+    static string Name(int schedule);
+
+private:
+
+};
+
+} }
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * \file
+ * \brief Block update scheme functions realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Scheme.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Name of scheme.
+ *
+ * \param[in] scheme - scheme
+ *
+ * \return
+ * Name of scheme.
+ */
+string Scheme::Name(int scheme)
+{
+    switch (scheme)
+    {
+        case Reference:
+            return "Reference";
+
+        case Two_Phase:
+            return "Two_Phase";
+
+        case Fused:
+            return "Fused";
+
+        default:
+            assert(false);
+    }
+}
+
+} }
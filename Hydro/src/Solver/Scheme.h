@@ -0,0 +1,44 @@
+/**
+ * \file
+ * \brief Block update scheme.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_SCHEME_H
+#define HYDRO_SOLVER_SCHEME_H
+
+#include <cassert>
+#include "Lib/IO/io.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Block update scheme.
+ */
+class Scheme
+{
+
+public:
+
+    /**
+     * \brief Schemes enumeration.
+     */
+    enum
+    {
+        Reference = 0, /**< cell gives flow to its neighbour (writes into not owned cells) */
+        Two_Phase = 1, /**< faces flows are calculated first, then each cell is updated */
+        Fused = 2,     /**< each row calculates its faces flows and is updated in one pass */
+        Count = 3      /**< count of schemes */
+    };
+
+    // Functions.
+    static string Name(int scheme);
+
+private:
+
+};
+
+} }
+
+#endif
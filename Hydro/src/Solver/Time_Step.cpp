@@ -0,0 +1,172 @@
+/**
+ * \file
+ * \brief Time step control realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include <mpi.h>
+#include <cmath>
+#include "Time_Step.h"
+#include "Row_Kernels.h"
+#include "Lib/OMP/omp.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Default constructor.
+ *
+ * \param[in] g_p - grid pointer
+ */
+Time_Step::Time_Step(Hydro::Grid::Grid *g_p)
+    : G_p_(g_p),
+      CFL_(0.5)
+{
+}
+
+/**
+ * \brief Default destructor.
+ */
+Time_Step::~Time_Step()
+{
+}
+
+/**
+ * \brief Calculate time step.
+ *
+ * \return
+ * Time step.
+ */
+double Time_Step::Calc_Dt()
+{
+    double rate = Max_Signal_Rate();
+
+    assert(rate > 0.0);
+
+    return CFL_ / rate;
+}
+
+/**
+ * \brief Maximum signal rate of grid.
+ *
+ * Active blocks are reduced locally, then maximum is reduced between ranks.
+ *
+ * \return
+ * Maximum signal rate.
+ */
+double Time_Step::Max_Signal_Rate()
+{
+    int layer = G_p_->Layer();
+    double rate = 0.0;
+
+    G_p_->Timer_Time_Step()->Start();
+
+    for (int i = 0; i < G_p_->Blocks_Count(); i++)
+    {
+        Block *b_p = G_p_->Get_Block(i);
+
+        if (b_p->Is_Active())
+        {
+            double block_rate = Max_Signal_Rate(b_p, layer);
+
+            rate = (block_rate > rate) ? block_rate : rate;
+        }
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, &rate, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    G_p_->Timer_Time_Step()->Stop();
+
+    return rate;
+}
+
+/**
+ * \brief Maximum signal rate of block.
+ *
+ * \param[in] b_p - block
+ * \param[in] layer - layer of cells data
+ *
+ * \return
+ * Maximum signal rate.
+ */
+double Time_Step::Max_Signal_Rate(Block *b_p,
+                                  int layer)
+{
+    return b_p->Is_SoA()
+           ? Max_Signal_Rate_SoA(b_p, layer)
+           : Max_Signal_Rate_AoS(b_p, layer);
+}
+
+/**
+ * \brief Maximum signal rate of block (array of structures storage).
+ *
+ * \param[in] b_p - block
+ * \param[in] layer - layer of cells data
+ *
+ * \return
+ * Maximum signal rate.
+ */
+double Time_Step::Max_Signal_Rate_AoS(Block *b_p,
+                                      int layer)
+{
+    const double g = Fluid_Dyn_Pars::Gamma;
+    int cells_count = b_p->Cells_Count();
+    double rate = 0.0;
+
+    #pragma omp parallel for reduction(max:rate)
+    for (int i = 0; i < cells_count; i++)
+    {
+        const Cell *c_p = &b_p->Cells[i];
+        const Fluid_Dyn_Pars &u = c_p->U[layer];
+        double c = sqrt(g * u.P / u.R);
+        double ri = (fabs(u.V.X) + c) * (c_p->S[Direction::I0] + c_p->S[Direction::I1]);
+        double rj = (fabs(u.V.Y) + c) * (c_p->S[Direction::J0] + c_p->S[Direction::J1]);
+        double rk = (fabs(u.V.Z) + c) * (c_p->S[Direction::K0] + c_p->S[Direction::K1]);
+        double r = 0.5 * (ri + rj + rk) / c_p->Vo;
+
+        rate = (r > rate) ? r : rate;
+    }
+
+    return rate;
+}
+
+/**
+ * \brief Maximum signal rate of block (structure of arrays storage).
+ *
+ * Rows of cells are distributed between threads.
+ *
+ * \param[in] b_p - block
+ * \param[in] layer - layer of cells data
+ *
+ * \return
+ * Maximum signal rate.
+ */
+double Time_Step::Max_Signal_Rate_SoA(Block *b_p,
+                                      int layer)
+{
+    int i_size = b_p->I_Size();
+    int rows_count = b_p->J_Size() * b_p->K_Size();
+    const Cells_SoA *soa_p = b_p->SoA;
+    double rate = 0.0;
+
+    #pragma omp parallel for reduction(max:rate)
+    for (int r = 0; r < rows_count; r++)
+    {
+        int c0 = r * i_size;
+        const double *s[Direction::Count];
+
+        for (int d = 0; d < Direction::Count; d++)
+        {
+            s[d] = soa_p->S[d] + c0;
+        }
+
+        double row_rate = Row_Kernels::Max_Signal_Rate(soa_p->U[layer].Shift(c0),
+                                                       soa_p->Vo + c0, s, i_size);
+
+        rate = (row_rate > rate) ? row_rate : rate;
+    }
+
+    return rate;
+}
+
+} }
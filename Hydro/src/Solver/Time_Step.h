@@ -0,0 +1,62 @@
+/**
+ * \file
+ * \brief Time step control.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_TIME_STEP_H
+#define HYDRO_SOLVER_TIME_STEP_H
+
+#include "Grid/Grid.h"
+
+using namespace Hydro::Grid;
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Time step control.
+ *
+ * Time step is calculated from CFL number and maximum signal rate of grid cells.
+ * Signal rate is reduced over threads for each block and over ranks for the grid,
+ * so all ranks use the same time step.
+ */
+class Time_Step
+{
+
+public:
+
+    // Constructors/destructors.
+    Time_Step(Hydro::Grid::Grid *g_p);
+    ~Time_Step();
+
+    // CFL number.
+    double Get_CFL() const { return CFL_; }
+    void Set_CFL(double cfl) { assert(cfl > 0.0); CFL_ = cfl; }
+
+    // Time step.
+    double Calc_Dt();
+
+    // Maximum signal rate.
+    double Max_Signal_Rate();
+    static double Max_Signal_Rate(Block *b_p,
+                                  int layer);
+
+private:
+
+    // Grid.
+    Hydro::Grid::Grid *G_p_;
+
+    // CFL number.
+    double CFL_;
+
+    // Maximum signal rate of block for different storages.
+    static double Max_Signal_Rate_AoS(Block *b_p,
+                                      int layer);
+    static double Max_Signal_Rate_SoA(Block *b_p,
+                                      int layer);
+};
+
+} }
+
+#endif
@@ -0,0 +1,35 @@
+/**
+ * \file
+ * \brief Cells traversal order functions realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Traversal.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Name of traversal order.
+ *
+ * \param[in] traversal - traversal order
+ *
+ * \return
+ * Name of traversal order.
+ */
+string Traversal::Name(int traversal)
+{
+    switch (traversal)
+    {
+        case Legacy:
+            return "Legacy";
+
+        case Memory:
+            return "Memory";
+
+        default:
+            assert(false);
+    }
+}
+
+} }
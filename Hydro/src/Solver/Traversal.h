@@ -0,0 +1,43 @@
+/**
+ * \file
+ * \brief Cells traversal order.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef HYDRO_SOLVER_TRAVERSAL_H
+#define HYDRO_SOLVER_TRAVERSAL_H
+
+#include <cassert>
+#include "Lib/IO/io.h"
+
+namespace Hydro { namespace Solver {
+
+/**
+ * \brief Cells traversal order.
+ */
+class Traversal
+{
+
+public:
+
+    /**
+     * \brief Traversal orders enumeration.
+     */
+    enum
+    {
+        Legacy = 0, /**< i is outer loop, k is inner loop (jump I * J cells each step) */
+        Memory = 1, /**< tiles in memory order, cells of tile in memory order */
+        Count = 2   /**< count of orders */
+    };
+
+    // Functions.
+    static string Name(int traversal);
+
+private:
+
+};
+
+} }
+
+#endif
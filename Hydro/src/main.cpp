@@ -9,7 +9,13 @@
 #include "Lib/OMP/omp.h"
 #include "Grid/Grid.h"
 #include "Solver/Godunov_1.h"
+#include "Solver/Godunov_2.h"
+#include "Solver/Riemann.h"
+#include "Solver/Riemann_HLL.h"
+#include "Solver/Riemann_HLLC.h"
+#include "Solver/Riemann_Roe.h"
 #include <stdlib.h>
+#include <cassert>
 
 /**
  * \brief Name of grid.
@@ -49,19 +55,29 @@ int Run(int ranks_count,
     grid_p->Print_Timers(out);
     grid_p->Print_Statistics(out);
     grid_p->Print_Blocks_Distribution(out, ranks_count);
+    grid_p->Print_Exchange_Plan(out);
     delete grid_p;
     out.close();
+
+    return 0;
 }
 
 /**
  * \brief Run solid descartes test.
+ *
+ * \param[in] nth - threads count
+ * \param[in] storage - cells storage mode
  */
-int Run_Solid_Descartes(int nth)
+int Run_Solid_Descartes(int nth,
+                        int storage)
 {
     omp_set_num_threads(nth);
-    cout << "Run_Solid_Descartes : max threads = " << omp_get_max_threads() << endl;
+    cout << "Run_Solid_Descartes : max threads = " << omp_get_max_threads()
+         << ", storage = " << Storage::Name(storage) << endl;
     Grid *grid_p = new Grid();
-    Godunov_1 *calculation_p = new Godunov_1(grid_p);
+    Godunov_1<> *calculation_p = new Godunov_1<>(grid_p);
+
+    grid_p->Set_Storage(storage);
 
     grid_p->Create_Solid_Descartes(1000, 1000, 1, 1.0, 1.0, 1.0);
     Lib::OMP::Timer *t_p = new Lib::OMP::Timer();
@@ -79,6 +95,12 @@ int Run_Solid_Descartes(int nth)
     {
         Block *b_p = grid_p->Get_Block(0);
         int lay = grid_p->Layer();
+        Fluid_Dyn_Pars u[10];
+
+        for (int i = 0; i < 10; i++)
+        {
+            b_p->Get_U(i, lay, u[i]);
+        }
 
         cout << "------------------------------------------------------------------------"
              << "------------------------------------------" << endl;
@@ -86,42 +108,42 @@ int Run_Solid_Descartes(int nth)
         cout << "Ro :";
         for (int i = 0; i < 10; i++)
         {
-            cout << " " << setw(10) << b_p->Cells[i].U[lay].R;
+            cout << " " << setw(10) << u[i].R;
         }
         cout << endl;
 
         cout << "Vx :";
         for (int i = 0; i < 10; i++)
         {
-            cout << " " << setw(10) << b_p->Cells[i].U[lay].V.X;
+            cout << " " << setw(10) << u[i].V.X;
         }
         cout << endl;
 
         cout << "Vy :";
         for (int i = 0; i < 10; i++)
         {
-            cout << " " << setw(10) << b_p->Cells[i].U[lay].V.Y;
+            cout << " " << setw(10) << u[i].V.Y;
         }
         cout << endl;
 
         cout << "Vz :";
         for (int i = 0; i < 10; i++)
         {
-            cout << " " << setw(10) << b_p->Cells[i].U[lay].V.Z;
+            cout << " " << setw(10) << u[i].V.Z;
         }
         cout << endl;
 
         cout << "E  :";
         for (int i = 0; i < 10; i++)
         {
-            cout << " " << setw(10) << b_p->Cells[i].U[lay].E;
+            cout << " " << setw(10) << u[i].E;
         }
         cout << endl;
 
         cout << "P  :";
         for (int i = 0; i < 10; i++)
         {
-            cout << " " << setw(10) << b_p->Cells[i].U[lay].P;
+            cout << " " << setw(10) << u[i].P;
         }
         cout << endl;
 
@@ -133,7 +155,608 @@ int Run_Solid_Descartes(int nth)
         break;
     }
 
+    delete calculation_p;
+    delete grid_p;
+
+    return 0;
+}
+
+/**
+ * \brief Prepare grid for benchmarks.
+ *
+ * GEOM grid files contain only blocks sizes and interfaces,
+ * so cells of each block are set up as unit cubes.
+ * Special name "descartes" means single block Descartes grid.
+ *
+ * \param[in,out] grid_p - grid
+ * \param[in] name - grid name
+ *
+ * \return
+ * true - if grid is created,
+ * false - in other cases.
+ */
+bool Create_Benchmark_Grid(Grid *grid_p,
+                           const string name)
+{
+    if (name == "descartes")
+    {
+        grid_p->Create_Solid_Descartes(200, 200, 50, 1.0, 1.0, 0.25);
+
+        return true;
+    }
+
+    if (!grid_p->Load_GEOM(name, Lib::MPI::Ranks_Count()))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < grid_p->Blocks_Count(); i++)
+    {
+        Block *b_p = grid_p->Get_Block(i);
+
+        if (b_p->Is_Active())
+        {
+            b_p->Create_Solid_Descartes(b_p->I_Size(), b_p->J_Size(), b_p->K_Size());
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \brief Benchmark of cells traversal orders.
+ *
+ * Throughput of Godunov_1 iterations is measured for legacy traversal (i is outer loop)
+ * and for memory order traversal with different tiles.
+ *
+ * \param[in] name - grid name
+ * \param[in] nth - threads count
+ * \param[in] storage - cells storage mode
+ */
+int Run_Traversal_Benchmark(const string name,
+                            int nth,
+                            int storage)
+{
+    const int iters = 10;
+    const int configs_count = 6;
+    const int configs[configs_count][4] =
+    {
+        {Traversal::Legacy, 0, 0, 0},
+        {Traversal::Memory, 0, 1, 1},
+        {Traversal::Memory, 0, 4, 4},
+        {Traversal::Memory, 0, 8, 8},
+        {Traversal::Memory, 0, 16, 16},
+        {Traversal::Memory, 64, 8, 8}
+    };
+
+    omp_set_num_threads(nth);
+    Grid *grid_p = new Grid();
+    grid_p->Set_Storage(storage);
+    if (!Create_Benchmark_Grid(grid_p, name))
+    {
+        delete grid_p;
+
+        return 1;
+    }
+
+    Godunov_1<> *calculation_p = new Godunov_1<>(grid_p);
+    double cells = 0.0;
+
+    for (int i = 0; i < grid_p->Blocks_Count(); i++)
+    {
+        Block *b_p = grid_p->Get_Block(i);
+
+        if (b_p->Is_Active())
+        {
+            cells += b_p->Cells_Count();
+        }
+    }
+
+    cout << "Run_Traversal_Benchmark : grid = " << name
+         << ", max threads = " << omp_get_max_threads()
+         << ", storage = " << Storage::Name(storage)
+         << ", cells = " << cells << endl;
+
+    for (int c = 0; c < configs_count; c++)
+    {
+        calculation_p->Set_Traversal(configs[c][0]);
+        calculation_p->Set_Tiles(configs[c][1], configs[c][2], configs[c][3]);
+
+        // Warm up.
+        calculation_p->Calc_Iter(1.0e-6);
+
+        Lib::OMP::Timer *t_p = new Lib::OMP::Timer();
+        t_p->Start();
+        calculation_p->Calc_Iters(iters, 1.0e-6);
+        t_p->Stop();
+
+        cout << "  " << setw(6) << Traversal::Name(configs[c][0]);
+        if (configs[c][0] == Traversal::Memory)
+        {
+            cout << " tile [" << setw(3) << configs[c][1] << ","
+                 << setw(3) << configs[c][2] << ","
+                 << setw(3) << configs[c][3] << "]";
+        }
+        else
+        {
+            cout << "                   ";
+        }
+        cout << " : time " << setw(10) << setprecision(4) << fixed << t_p->Time()
+             << " s, " << setw(10) << setprecision(2) << fixed
+             << (cells * iters / t_p->Time() * 1.0e-6) << " Mcells/s" << endl;
+
+        delete t_p;
+    }
+
+    delete calculation_p;
+    delete grid_p;
+
+    return 0;
+}
+
+/**
+ * \brief Benchmark of block update schemes.
+ *
+ * Throughput of Godunov_1 iterations is measured for all schemes
+ * (structure of arrays storage is used since new schemes need it).
+ *
+ * \param[in] name - grid name
+ * \param[in] nth - threads count
+ */
+template <class Riemann_Solver>
+int Run_Schemes_Benchmark(const string name,
+                          int nth)
+{
+    const int iters = 10;
+
+    omp_set_num_threads(nth);
+    Grid *grid_p = new Grid();
+    grid_p->Set_Storage(Storage::SoA);
+    if (!Create_Benchmark_Grid(grid_p, name))
+    {
+        delete grid_p;
+
+        return 1;
+    }
+
+    Godunov_1<Riemann_Solver> *calculation_p = new Godunov_1<Riemann_Solver>(grid_p);
+    double cells = 0.0;
+
+    for (int i = 0; i < grid_p->Blocks_Count(); i++)
+    {
+        Block *b_p = grid_p->Get_Block(i);
+
+        if (b_p->Is_Active())
+        {
+            cells += b_p->Cells_Count();
+        }
+    }
+
+    cout << "Run_Schemes_Benchmark : grid = " << name
+         << ", max threads = " << omp_get_max_threads()
+         << ", riemann = " << Riemann_Solver::Name()
+         << " (kernel " << Riemann::Kernel_Name() << ")"
+         << ", cells = " << cells << endl;
+
+    for (int s = 0; s < Scheme::Count; s++)
+    {
+        calculation_p->Set_Scheme(s);
+
+        // Warm up.
+        calculation_p->Calc_Iter(1.0e-6);
+
+        Lib::OMP::Timer *t_p = new Lib::OMP::Timer();
+        t_p->Start();
+        calculation_p->Calc_Iters(iters, 1.0e-6);
+        t_p->Stop();
+
+        cout << "  " << setw(9) << Scheme::Name(s)
+             << " : time " << setw(10) << setprecision(4) << fixed << t_p->Time()
+             << " s, " << setw(10) << setprecision(2) << fixed
+             << (cells * iters / t_p->Time() * 1.0e-6) << " Mcells/s" << endl;
+
+        delete t_p;
+    }
+
+    delete calculation_p;
+    delete grid_p;
+
+    return 0;
+}
+
+/**
+ * \brief Benchmark of second order solver.
+ *
+ * Throughput of Godunov_2 iterations is measured for all limiters
+ * and compared with fused scheme of Godunov_1 with the same Riemann solver.
+ *
+ * \param[in] name - grid name
+ * \param[in] nth - threads count
+ */
+template <class Riemann_Solver>
+int Run_MUSCL_Benchmark(const string name,
+                        int nth)
+{
+    const int iters = 10;
+
+    omp_set_num_threads(nth);
+    Grid *grid_p = new Grid();
+    grid_p->Set_Storage(Storage::SoA);
+    if (!Create_Benchmark_Grid(grid_p, name))
+    {
+        delete grid_p;
+
+        return 1;
+    }
+
+    double cells = 0.0;
+
+    for (int i = 0; i < grid_p->Blocks_Count(); i++)
+    {
+        Block *b_p = grid_p->Get_Block(i);
+
+        if (b_p->Is_Active())
+        {
+            cells += b_p->Cells_Count();
+        }
+    }
+
+    cout << "Run_MUSCL_Benchmark : grid = " << name
+         << ", max threads = " << omp_get_max_threads()
+         << ", riemann = " << Riemann_Solver::Name()
+         << ", cells = " << cells << endl;
+
+    for (int l = -1; l < Limiter::Count; l++)
+    {
+        Godunov_1<Riemann_Solver> *first_p = NULL;
+        Godunov_2<Riemann_Solver> *second_p = NULL;
+
+        if (l < 0)
+        {
+            first_p = new Godunov_1<Riemann_Solver>(grid_p);
+            first_p->Set_Scheme(Scheme::Fused);
+        }
+        else
+        {
+            second_p = new Godunov_2<Riemann_Solver>(grid_p);
+            second_p->Set_Limiter(l);
+        }
+
+        // Warm up.
+        if (first_p != NULL)
+        {
+            first_p->Calc_Iter(1.0e-6);
+        }
+        else
+        {
+            second_p->Calc_Iter(1.0e-6);
+        }
+
+        Lib::OMP::Timer *t_p = new Lib::OMP::Timer();
+        t_p->Start();
+        if (first_p != NULL)
+        {
+            first_p->Calc_Iters(iters, 1.0e-6);
+        }
+        else
+        {
+            second_p->Calc_Iters(iters, 1.0e-6);
+        }
+        t_p->Stop();
+
+        cout << "  " << setw(18)
+             << ((l < 0) ? string("Godunov_1 Fused") : ("Godunov_2 " + Limiter::Name(l)))
+             << " : time " << setw(10) << setprecision(4) << fixed << t_p->Time()
+             << " s, " << setw(10) << setprecision(2) << fixed
+             << (cells * iters / t_p->Time() * 1.0e-6) << " Mcells/s" << endl;
+
+        delete t_p;
+        delete first_p;
+        delete second_p;
+    }
+
+    delete grid_p;
+
+    return 0;
+}
+
+/**
+ * \brief Benchmark of blocks calculation schedules.
+ *
+ * Throughput and threads utilization are measured for faces flows schemes
+ * with all schedules, for overlap schedules part of shadows exchange time
+ * hidden by inner cells calculation is shown (times and cells of rank 0 are printed).
+ *
+ * \param[in] name - grid name
+ * \param[in] nth - threads count
+ */
+int Run_Schedules_Benchmark(const string name,
+                            int nth)
+{
+    const int iters = 10;
+    bool is_master = (Lib::MPI::Rank() == 0);
+
+    omp_set_num_threads(nth);
+    Grid *grid_p = new Grid();
+    grid_p->Set_Storage(Storage::SoA);
+    if (!Create_Benchmark_Grid(grid_p, name))
+    {
+        delete grid_p;
+
+        return 1;
+    }
+
+    Godunov_1<> *calculation_p = new Godunov_1<>(grid_p);
+    double cells = 0.0;
+
+    for (int i = 0; i < grid_p->Blocks_Count(); i++)
+    {
+        Block *b_p = grid_p->Get_Block(i);
+
+        if (b_p->Is_Active())
+        {
+            cells += b_p->Cells_Count();
+        }
+    }
+
+    if (is_master)
+    {
+        cout << "Run_Schedules_Benchmark : grid = " << name
+             << ", max threads = " << omp_get_max_threads()
+             << ", blocks = " << grid_p->Blocks_Count()
+             << ", cells = " << cells << endl;
+    }
+
+    calculation_p->Set_Tiles(0, 8, 8);
+
+    for (int s = Scheme::Two_Phase; s < Scheme::Count; s++)
+    {
+        for (int sh = 0; sh < Schedule::Count; sh++)
+        {
+            calculation_p->Set_Scheme(s);
+            calculation_p->Set_Schedule(sh);
+
+            // Warm up.
+            calculation_p->Calc_Iter(1.0e-6);
+
+            calculation_p->Get_Threads_Timer().Init();
+            grid_p->Timer_Shadow_Exchange()->Init();
+            grid_p->Timer_Shadow_Wait()->Init();
+            calculation_p->Calc_Iters(iters, 1.0e-6);
+
+            if (is_master)
+            {
+                Lib::OMP::Threads_Timer &t = calculation_p->Get_Threads_Timer();
+                cout << "  " << setw(9) << Scheme::Name(s) << " " << setw(8)
+                     << Schedule::Name(calculation_p->Get_Schedule())
+                     << " : time " << setw(10) << setprecision(4) << fixed << t.Time()
+                     << " s, " << setw(10) << setprecision(2) << fixed
+                     << (cells * iters / t.Time() * 1.0e-6) << " Mcells/s" << endl;
+                t.Print(cout);
+
+                double exchange = grid_p->Timer_Shadow_Exchange()->Time();
+                double wait = grid_p->Timer_Shadow_Wait()->Time();
+                cout << "  shadows exchange " << setprecision(4) << fixed << exchange
+                     << " s, wait " << wait << " s, hidden " << (exchange - wait) << " s"
+                     << endl;
+            }
+        }
+    }
+
+    delete calculation_p;
     delete grid_p;
+
+    return 0;
+}
+
+/**
+ * \brief Benchmark of interfaces exchange modes.
+ *
+ * Shadows exchange is measured for all exchange modes and for peers exchange
+ * with reduced precisions, exchange plan and precision errors of rank 0 are printed.
+ *
+ * \param[in] name - grid name
+ * \param[in] nth - threads count
+ */
+int Run_Exchange_Benchmark(const string name,
+                           int nth)
+{
+    const int iters = 100;
+    bool is_master = (Lib::MPI::Rank() == 0);
+
+    omp_set_num_threads(nth);
+    Grid *grid_p = new Grid();
+    grid_p->Set_Storage(Storage::SoA);
+    if (!Create_Benchmark_Grid(grid_p, name))
+    {
+        delete grid_p;
+
+        return 1;
+    }
+
+    if (is_master)
+    {
+        cout << "Run_Exchange_Benchmark : grid = " << name
+             << ", ranks = " << Lib::MPI::Ranks_Count()
+             << ", max threads = " << omp_get_max_threads() << endl;
+    }
+
+    // Exchange modes with double precision and peers exchange with reduced precisions.
+    for (int c = 0; c < Exchange::Count + Precision::Count - 1; c++)
+    {
+        int e = (c < Exchange::Count) ? c : Exchange::Peers;
+        int pr = (c < Exchange::Count) ? Precision::Double : (c - Exchange::Count + 1);
+        Lib::MPI::Timer t;
+
+        grid_p->Set_Exchange(e);
+        grid_p->Set_Precision(pr, Precision::Keep_None);
+
+        // Warm up.
+        grid_p->Exchange_Shadows();
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        t.Start();
+        for (int i = 0; i < iters; i++)
+        {
+            grid_p->Exchange_Shadows();
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+        t.Stop();
+
+        if (is_master)
+        {
+            grid_p->Print_Exchange_Plan();
+            if (pr != Precision::Double)
+            {
+                grid_p->Print_Precision_Errors();
+            }
+            cout << "  " << setw(9) << Exchange::Name(e) << " " << setw(6) << Precision::Name(pr)
+                 << " : exchange " << setprecision(6) << fixed << (t.Time() / iters) << " s"
+                 << endl;
+        }
+    }
+
+    delete grid_p;
+
+    return 0;
+}
+
+/**
+ * \brief Benchmark of blocks ranks balancing modes.
+ *
+ * Grid is distributed between ranks by all balancing modes (and from partition file),
+ * blocks distribution (with edge cut and imbalance) is printed by rank 0.
+ *
+ * \param[in] name - grid name
+ * \param[in] splitting - count of blocks per rank for blocks splitting (0 - no splitting)
+ * \param[in] partition - partition file (loaded after balancing modes if it is not empty)
+ */
+int Run_Balancing_Benchmark(const string name,
+                            int splitting,
+                            const string partition)
+{
+    bool is_master = (Lib::MPI::Rank() == 0);
+    int count = partition.empty() ? Balancing::Count : (Balancing::Count + 1);
+
+    for (int b = 0; b < count; b++)
+    {
+        Grid *grid_p = new Grid();
+        bool is_partition = (b == Balancing::Count);
+
+        grid_p->Set_Balancing(is_partition ? Balancing::Cells : b);
+        grid_p->Set_Blocks_Splitting(splitting);
+        if (is_partition)
+        {
+            grid_p->Set_Partition(partition);
+        }
+        if (!grid_p->Load_GEOM(name, Lib::MPI::Ranks_Count()))
+        {
+            delete grid_p;
+
+            return 1;
+        }
+
+        if (is_master)
+        {
+            cout << "Run_Balancing_Benchmark : grid = " << name
+                 << ", ranks = " << Lib::MPI::Ranks_Count()
+                 << ", splitting = " << splitting
+                 << ", blocks = " << grid_p->Blocks_Count()
+                 << ", balancing = " << (is_partition ? partition : Balancing::Name(b))
+                 << endl;
+            grid_p->Print_Blocks_Distribution(cout, Lib::MPI::Ranks_Count());
+        }
+
+        delete grid_p;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Benchmark of dynamic rebalancing.
+ *
+ * Grid starts with circular distribution of blocks (migrated after loading),
+ * blocks calculation times are checked every few iterations and blocks are migrated
+ * if imbalance is above threshold, iteration time and imbalances are printed by rank 0.
+ *
+ * \param[in] name - grid name
+ * \param[in] nth - threads count
+ * \param[in] threshold - tolerance of imbalance
+ */
+int Run_Rebalancing_Benchmark(const string name,
+                              int nth,
+                              double threshold)
+{
+    const int checks = 5;
+    const int iters = 10;
+    bool is_master = (Lib::MPI::Rank() == 0);
+
+    omp_set_num_threads(nth);
+    Grid *grid_p = new Grid();
+    grid_p->Set_Storage(Storage::SoA);
+    if (!Create_Benchmark_Grid(grid_p, name))
+    {
+        delete grid_p;
+
+        return 1;
+    }
+
+    vector<int> ranks(grid_p->Blocks_Count());
+
+    for (int i = 0; i < grid_p->Blocks_Count(); i++)
+    {
+        ranks[i] = i % Lib::MPI::Ranks_Count();
+    }
+
+    grid_p->Migrate_Blocks(ranks);
+
+    if (is_master)
+    {
+        cout << "Run_Rebalancing_Benchmark : grid = " << name
+             << ", ranks = " << Lib::MPI::Ranks_Count()
+             << ", max threads = " << omp_get_max_threads()
+             << ", threshold = " << setprecision(2) << fixed << threshold << endl;
+    }
+
+    Godunov_1<> *calculation_p = new Godunov_1<>(grid_p);
+
+    calculation_p->Set_Tiles(0, 8, 8);
+    calculation_p->Set_Scheme(Scheme::Fused);
+    grid_p->Reset_Blocks_Calc_Times();
+
+    for (int c = 0; c < checks; c++)
+    {
+        Lib::MPI::Timer t;
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        t.Start();
+        calculation_p->Calc_Iters(iters, 1.0e-6);
+        MPI_Barrier(MPI_COMM_WORLD);
+        t.Stop();
+
+        bool is_migrated = grid_p->Rebalance(threshold);
+
+        if (is_master)
+        {
+            cout << "  check " << c << " : iteration " << setprecision(6) << fixed
+                 << (t.Time() / iters) << " s, imbalance " << setprecision(2)
+                 << (grid_p->Imbalance_Before() * 100.0) << " % -> "
+                 << (grid_p->Imbalance_After() * 100.0) << " %"
+                 << (is_migrated ? ", migrated" : "") << endl;
+        }
+    }
+
+    if (is_master)
+    {
+        grid_p->Print_Rebalancing();
+        grid_p->Print_Blocks_Distribution(cout, Lib::MPI::Ranks_Count());
+    }
+
+    delete calculation_p;
+    delete grid_p;
+
+    return 0;
 }
 
 /**
@@ -144,8 +767,107 @@ int Run_Solid_Descartes(int nth)
  */
 int main(int argc, char **argv)
 {
-    MPI_Init(&argc, &argv);
-    Run_Solid_Descartes(atoi(argv[1]));
+    // Progress schedule drives shadows exchange from master thread while other threads
+    // calculate, so threads support is requested (without it solver uses overlap schedule).
+    int provided;
+
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+
+    /*
+     * Arguments:
+     *   <threads> [aos|soa] - solid descartes test,
+     *   traversal <threads> [aos|soa] [grid] - traversal orders benchmark,
+     *   schemes <threads> [grid] [avg|hll|hllc|roe] - block update schemes benchmark,
+     *   muscl <threads> [grid] [hll|hllc|roe] - second order solver benchmark,
+     *   schedules <threads> [grid] - blocks calculation schedules benchmark,
+     *   exchange <threads> [grid] - interfaces exchange modes benchmark,
+     *   balancing [grid] [blocks_per_rank] [partition] - blocks ranks balancing benchmark,
+     *   rebalancing <threads> [grid] [threshold] - dynamic rebalancing benchmark.
+     */
+    assert(argc >= 2);
+    string mode(argv[1]);
+    if (mode == "traversal")
+    {
+        assert(argc >= 3);
+        int storage = ((argc > 3) && (string(argv[3]) == "soa"))
+                      ? Storage::SoA
+                      : Storage::AoS;
+        string name = (argc > 4) ? argv[4] : GRID_NAME;
+        Run_Traversal_Benchmark(name, atoi(argv[2]), storage);
+    }
+    else if (mode == "schemes")
+    {
+        assert(argc >= 3);
+        string name = (argc > 3) ? argv[3] : GRID_NAME;
+        string riemann = (argc > 4) ? argv[4] : "avg";
+        if (riemann == "hll")
+        {
+            Run_Schemes_Benchmark<Riemann_HLL>(name, atoi(argv[2]));
+        }
+        else if (riemann == "hllc")
+        {
+            Run_Schemes_Benchmark<Riemann_HLLC>(name, atoi(argv[2]));
+        }
+        else if (riemann == "roe")
+        {
+            Run_Schemes_Benchmark<Riemann_Roe>(name, atoi(argv[2]));
+        }
+        else
+        {
+            Run_Schemes_Benchmark<Riemann_Avg>(name, atoi(argv[2]));
+        }
+    }
+    else if (mode == "muscl")
+    {
+        assert(argc >= 3);
+        string name = (argc > 3) ? argv[3] : GRID_NAME;
+        string riemann = (argc > 4) ? argv[4] : "hllc";
+        if (riemann == "hll")
+        {
+            Run_MUSCL_Benchmark<Riemann_HLL>(name, atoi(argv[2]));
+        }
+        else if (riemann == "roe")
+        {
+            Run_MUSCL_Benchmark<Riemann_Roe>(name, atoi(argv[2]));
+        }
+        else
+        {
+            Run_MUSCL_Benchmark<Riemann_HLLC>(name, atoi(argv[2]));
+        }
+    }
+    else if (mode == "schedules")
+    {
+        assert(argc >= 3);
+        string name = (argc > 3) ? argv[3] : GRID_NAME;
+        Run_Schedules_Benchmark(name, atoi(argv[2]));
+    }
+    else if (mode == "exchange")
+    {
+        assert(argc >= 3);
+        string name = (argc > 3) ? argv[3] : GRID_NAME;
+        Run_Exchange_Benchmark(name, atoi(argv[2]));
+    }
+    else if (mode == "balancing")
+    {
+        string name = (argc > 2) ? argv[2] : GRID_NAME;
+        int splitting = (argc > 3) ? atoi(argv[3]) : 0;
+        string partition = (argc > 4) ? argv[4] : "";
+        Run_Balancing_Benchmark(name, splitting, partition);
+    }
+    else if (mode == "rebalancing")
+    {
+        assert(argc >= 3);
+        string name = (argc > 3) ? argv[3] : GRID_NAME;
+        double threshold = (argc > 4) ? atof(argv[4]) : 0.1;
+        Run_Rebalancing_Benchmark(name, atoi(argv[2]), threshold);
+    }
+    else
+    {
+        int storage = ((argc > 2) && (string(argv[2]) == "soa"))
+                      ? Storage::SoA
+                      : Storage::AoS;
+        Run_Solid_Descartes(atoi(argv[1]), storage);
+    }
     MPI_Finalize();
 
     return 0;
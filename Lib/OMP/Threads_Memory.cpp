@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \brief OMP threads work memory realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <omp.h>
+#include "Threads_Memory.h"
+
+namespace Lib { namespace OMP {
+
+/*
+ * Constructors/destructors.
+ */
+
+/**
+ * \brief Default constructor.
+ */
+Threads_Memory::Threads_Memory()
+    : Threads_Count_(0),
+      Memory_p_(NULL),
+      Sizes_p_(NULL)
+{
+    Init();
+}
+
+/**
+ * \brief Default destructor.
+ */
+Threads_Memory::~Threads_Memory()
+{
+    Deallocate();
+}
+
+/*
+ * General commands.
+ */
+
+/**
+ * \brief Initialization (for current maximum threads count).
+ *
+ * Arrays are kept if maximum threads count is not increased.
+ */
+void Threads_Memory::Init()
+{
+    if (Threads_Count_ >= omp_get_max_threads())
+    {
+        return;
+    }
+
+    Deallocate();
+    Threads_Count_ = omp_get_max_threads();
+    Memory_p_ = new double *[Threads_Count_];
+    Sizes_p_ = new int[Threads_Count_];
+
+    for (int t = 0; t < Threads_Count_; t++)
+    {
+        Memory_p_[t] = NULL;
+        Sizes_p_[t] = 0;
+    }
+}
+
+/**
+ * \brief Deallocate memory of all threads.
+ */
+void Threads_Memory::Deallocate()
+{
+    if (Memory_p_ != NULL)
+    {
+        for (int t = 0; t < Threads_Count_; t++)
+        {
+            delete [] Memory_p_[t];
+        }
+
+        delete [] Memory_p_;
+        delete [] Sizes_p_;
+        Memory_p_ = NULL;
+        Sizes_p_ = NULL;
+        Threads_Count_ = 0;
+    }
+}
+
+/*
+ * Memory of thread.
+ */
+
+/**
+ * \brief Get memory of current thread.
+ *
+ * Array of thread is reallocated if it is smaller than requested,
+ * its content is not kept between requests.
+ *
+ * \param[in] size - count of doubles
+ *
+ * \return
+ * Memory of thread.
+ */
+double *Threads_Memory::Get(int size)
+{
+    int t = omp_get_thread_num();
+
+    assert(t < Threads_Count_);
+
+    if (Sizes_p_[t] < size)
+    {
+        delete [] Memory_p_[t];
+        Memory_p_[t] = new double[size];
+        Sizes_p_[t] = size;
+    }
+
+    return Memory_p_[t];
+}
+
+} }
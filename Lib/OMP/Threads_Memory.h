@@ -0,0 +1,51 @@
+/**
+ * \file
+ * \brief OMP threads work memory description.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef LIB_OMP_THREADS_MEMORY_H
+#define LIB_OMP_THREADS_MEMORY_H
+
+namespace Lib { namespace OMP {
+
+/**
+ * \brief Work memory of OMP threads.
+ *
+ * Each thread has its own array of doubles which grows on request and is reused,
+ * so parallel jobs do not allocate temporary memory every time.
+ * Arrays are indexed by thread number in current team, so only one team may use them.
+ */
+class Threads_Memory
+{
+
+public:
+
+    // Constructors/destructors.
+    Threads_Memory();
+    ~Threads_Memory();
+
+    // General commands (master thread).
+    void Init();
+    void Deallocate();
+
+    // Memory of thread (called by thread which uses it).
+    double *Get(int size);
+
+    // Simple data.
+    int Threads_Count() const { return Threads_Count_; }
+
+private:
+
+    // Count of threads.
+    int Threads_Count_;
+
+    // Arrays of threads and their sizes.
+    double **Memory_p_;
+    int *Sizes_p_;
+};
+
+} }
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * \file
+ * \brief OMP threads timer realization.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include <cassert>
+#include <iomanip>
+#include <omp.h>
+#include "Threads_Timer.h"
+
+namespace Lib { namespace OMP {
+
+/*
+ * Constructors/destructors.
+ */
+
+/**
+ * \brief Default constructor.
+ */
+Threads_Timer::Threads_Timer()
+    : Wall_(),
+      Threads_Count_(0),
+      Busy_p_(NULL)
+{
+    Init();
+}
+
+/**
+ * \brief Default destructor.
+ */
+Threads_Timer::~Threads_Timer()
+{
+    delete [] Busy_p_;
+}
+
+/*
+ * General commands.
+ */
+
+/**
+ * \brief Initialization (for current maximum threads count).
+ */
+void Threads_Timer::Init()
+{
+    Wall_.Init();
+
+    if (Threads_Count_ != omp_get_max_threads())
+    {
+        delete [] Busy_p_;
+        Threads_Count_ = omp_get_max_threads();
+        Busy_p_ = new double[Threads_Count_ * Busy_Stride];
+    }
+
+    for (int t = 0; t < Threads_Count_; t++)
+    {
+        Busy_p_[t * Busy_Stride] = 0.0;
+    }
+}
+
+/**
+ * \brief Start measurement.
+ *
+ * Timer is initialized again if maximum threads count was changed.
+ */
+void Threads_Timer::Start()
+{
+    if (Threads_Count_ != omp_get_max_threads())
+    {
+        Init();
+    }
+
+    Wall_.Start();
+}
+
+/**
+ * \brief Start job of thread.
+ *
+ * \return
+ * Start point.
+ */
+double Threads_Timer::Job_Start() const
+{
+    return omp_get_wtime();
+}
+
+/**
+ * \brief Stop job of thread.
+ *
+ * \param[in] start - start point (from Job_Start)
+ */
+void Threads_Timer::Job_Stop(double start)
+{
+    int t = omp_get_thread_num();
+
+    assert(t < Threads_Count_);
+
+    Busy_p_[t * Busy_Stride] += omp_get_wtime() - start;
+}
+
+/*
+ * Times.
+ */
+
+/**
+ * \brief Get busy time of thread.
+ *
+ * \param[in] t - thread number
+ *
+ * \return
+ * Busy time.
+ */
+double Threads_Timer::Busy_Time(int t) const
+{
+    assert((t >= 0) && (t < Threads_Count_));
+
+    return Busy_p_[t * Busy_Stride];
+}
+
+/**
+ * \brief Get utilization of threads (part of wall time when threads are busy).
+ *
+ * \return
+ * Utilization.
+ */
+double Threads_Timer::Utilization()
+{
+    double busy = 0.0;
+
+    for (int t = 0; t < Threads_Count_; t++)
+    {
+        busy += Busy_Time(t);
+    }
+
+    return (Time() > 0.0) ? (busy / (Time() * Threads_Count_)) : 0.0;
+}
+
+/*
+ * Print information.
+ */
+
+/**
+ * \brief Print busy and idle times of threads.
+ *
+ * \param[in] os - stream
+ */
+void Threads_Timer::Print(ostream &os)
+{
+    os << "Threads times (wall " << setprecision(4) << fixed << Time() << " s):" << endl;
+
+    for (int t = 0; t < Threads_Count_; t++)
+    {
+        os << "  thread " << setw(3) << t
+           << " : busy " << setw(10) << setprecision(4) << fixed << Busy_Time(t)
+           << " s, idle " << setw(10) << setprecision(4) << fixed << Idle_Time(t) << " s" << endl;
+    }
+
+    os << "  utilization : " << setprecision(2) << fixed << (100.0 * Utilization()) << " %" << endl;
+}
+
+} }
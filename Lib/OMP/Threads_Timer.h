@@ -0,0 +1,70 @@
+/**
+ * \file
+ * \brief OMP threads timer description.
+ *
+ * \author Alexey Rybakov
+ */
+
+#ifndef LIB_OMP_THREADS_TIMER_H
+#define LIB_OMP_THREADS_TIMER_H
+
+#include <iostream>
+#include "Timer.h"
+
+using namespace std;
+
+namespace Lib { namespace OMP {
+
+/**
+ * \brief OMP threads timer.
+ *
+ * Wall time of measured code is taken by master thread (outside parallel regions),
+ * busy time is accumulated by each thread for its own jobs,
+ * so idle time of thread (waiting, fork and join) is wall time without busy time.
+ */
+class Threads_Timer
+{
+
+public:
+
+    // Constructors/destructors.
+    Threads_Timer();
+    ~Threads_Timer();
+
+    // General commands (master thread).
+    void Init();
+    void Start();
+    void Stop() { Wall_.Stop(); }
+
+    // Job of thread (called by thread which does the job).
+    double Job_Start() const;
+    void Job_Stop(double start);
+
+    // Times.
+    int Threads_Count() const { return Threads_Count_; }
+    double Time() { return Wall_.Time(); }
+    double Busy_Time(int t) const;
+    double Idle_Time(int t) { return Time() - Busy_Time(t); }
+    double Utilization();
+
+    // Print information.
+    void Print(ostream &os);
+
+private:
+
+    // Wall time.
+    Timer Wall_;
+
+    // Count of threads.
+    int Threads_Count_;
+
+    // Busy times of threads (each thread has its own cache line).
+    double *Busy_p_;
+
+    // Distance between busy times of neighbour threads.
+    static const int Busy_Stride = 8;
+};
+
+} }
+
+#endif
@@ -10,6 +10,8 @@
 
 #include <omp.h>
 #include "Timer.h"
+#include "Threads_Timer.h"
+#include "Threads_Memory.h"
 
 namespace Lib { namespace OMP {
 
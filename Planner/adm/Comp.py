@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+
+'''
+Planner compilation script.
+
+Usage:
+  ./Comp.py - print this text
+  ./Comp.py local - build program for local run
+  ./Comp.py mvs - build program for mvs cluster
+'''
+
+import sys
+import subprocess
+
+#---------------------------------------------------------------------------------------------------
+# Globals.
+#---------------------------------------------------------------------------------------------------
+
+#---------------------------------------------------------------------------------------------------
+# Functions.
+#---------------------------------------------------------------------------------------------------
+
+'''
+Print help.
+'''
+def Print_Help():
+    print "Planner compilation script."
+    print ""
+    print "Usage:"
+    print "  ./Comp.py - print this text"
+    print "  ./Comp.py local - build program for local run"
+    print "  ./Comp.py mvs - build program for mvs cluster"
+
+#---------------------------------------------------------------------------------------------------
+# Script body.
+#---------------------------------------------------------------------------------------------------
+
+# Get argument.
+assert(len(sys.argv) == 2)
+arg = sys.argv[1]
+
+# Compilation parameters.
+srcs = "./src/*.cpp ../Hydro/src/Grid/*.cpp ../Lib/IO/*.cpp ../Lib/MPI/*.cpp ../Lib/Math/*.cpp ../Lib/OMP/*.cpp"
+cmds = []
+
+# Analyze argument.
+if (arg == "-h"):
+    Print_Help()
+elif (arg == "local"):
+    cmds = ["rm -f planner.*",
+            "mpic++ -O3 -march=native " + srcs + " -I./src -I../Hydro/src -I.. -o planner.local -lm -fopenmp"]
+elif (arg == "mvs"):
+    cmds = ["rm -f planner.*",
+            "mpicc -O3 " + srcs + " -I./src -I../Hydro/src -I.. -o planner.mvs -lm -fopenmp",
+            "mpicc -O3 " + srcs + " -I./src -I../Hydro/src -I.. -o planner.mvs.mic -mmic -lm -fopenmp"]
+else:
+    assert(False)
+
+# Run compilation.
+print "Prepare to execute commands:"
+if (cmds != []):
+    for cmd in cmds:
+        print "  " + cmd
+    cmd = reduce(lambda x, y: x + " ; " + y, cmds)
+    subprocess.call(cmd, shell = True)
+
+#---------------------------------------------------------------------------------------------------
+
@@ -0,0 +1,165 @@
+/**
+ * \file
+ * \brief Offline planner of blocks partitions for GEOM grids.
+ *
+ * \author Alexey Rybakov
+ */
+
+#include "Lib/MPI/mpi.h"
+#include "Grid/Grid.h"
+#include <stdlib.h>
+#include <cassert>
+#include <sstream>
+#include <fstream>
+#include <cctype>
+
+using namespace Hydro::Grid;
+
+/*
+ * Prototypes.
+ */
+bool Plan_Partition(const string name,
+                    int ranks_count,
+                    int balancing,
+                    int splitting,
+                    double imbalance,
+                    int ranks_per_node,
+                    ostream &report);
+string Partition_File_Name(const string name,
+                           int ranks_count,
+                           int balancing);
+
+/**
+ * \brief Enter point.
+ *
+ * Grid is partitioned by all balancing modes for each count of ranks,
+ * partitions are written into files (loadable by Grid::Set_Partition)
+ * and quality report is written into stdout and report file.
+ *
+ * Arguments:
+ *   <grid> "<ranks counts>" [blocks_per_rank] [imbalance] [ranks_per_node]
+ *
+ * \param[in] argc - arguments count
+ * \param[in] argv - arguments
+ *
+ * \return
+ * Status.
+ */
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+
+    // Grid and ranks counts are needed.
+    assert(argc >= 3);
+    string name(argv[1]);
+    istringstream pcs(argv[2]);
+    int splitting = (argc > 3) ? atoi(argv[3]) : 0;
+    double imbalance = (argc > 4) ? atof(argv[4]) : 0.05;
+    int ranks_per_node = (argc > 5) ? atoi(argv[5]) : 0;
+    string base = name.substr(name.find_last_of('/') + 1);
+    ostringstream report;
+    int pc;
+
+    report << "Partitions of grid " << name << " (splitting " << splitting
+           << ", imbalance tolerance " << imbalance
+           << ", ranks per node " << ranks_per_node << "):" << endl;
+
+    while (pcs >> pc)
+    {
+        for (int b = 0; b < Balancing::Count; b++)
+        {
+            if (!Plan_Partition(name, pc, b, splitting, imbalance, ranks_per_node, report))
+            {
+                MPI_Finalize();
+
+                return 1;
+            }
+        }
+    }
+
+    // Report.
+    ofstream file((base + ".report").c_str());
+
+    cout << report.str();
+    file << report.str();
+    file.close();
+
+    MPI_Finalize();
+
+    return 0;
+}
+
+/**
+ * \brief Partition grid for count of ranks by balancing mode and save partition.
+ *
+ * \param[in] name - grid name
+ * \param[in] ranks_count - count of ranks
+ * \param[in] balancing - balancing mode
+ * \param[in] splitting - count of blocks per rank for blocks splitting (0 - no splitting)
+ * \param[in] imbalance - tolerance of cells imbalance (for graph partitioning)
+ * \param[in] ranks_per_node - count of ranks per node (0 - all ranks are on one node)
+ * \param[out] report - report stream
+ *
+ * \return
+ * true - if partition is saved,
+ * false - in other cases.
+ */
+bool Plan_Partition(const string name,
+                    int ranks_count,
+                    int balancing,
+                    int splitting,
+                    double imbalance,
+                    int ranks_per_node,
+                    ostream &report)
+{
+    Grid *grid_p = new Grid();
+    string file_name = Partition_File_Name(name, ranks_count, balancing);
+
+    grid_p->Set_Planning(true);
+    grid_p->Set_Balancing(balancing, imbalance);
+    grid_p->Set_Blocks_Splitting(splitting);
+    grid_p->Set_Ranks_Per_Node(ranks_per_node);
+
+    if (!grid_p->Load_GEOM(name, ranks_count) || !grid_p->Save_Partition(file_name, ranks_count))
+    {
+        delete grid_p;
+
+        return false;
+    }
+
+    report << "ranks = " << ranks_count << ", blocks = " << grid_p->Blocks_Count()
+           << ", balancing = " << Balancing::Name(balancing)
+           << ", file = " << file_name << endl;
+    grid_p->Print_Partition_Quality(report, ranks_count);
+
+    delete grid_p;
+
+    return true;
+}
+
+/**
+ * \brief Name of partition file (in current directory).
+ *
+ * \param[in] name - grid name
+ * \param[in] ranks_count - count of ranks
+ * \param[in] balancing - balancing mode
+ *
+ * \return
+ * Name of file.
+ */
+string Partition_File_Name(const string name,
+                           int ranks_count,
+                           int balancing)
+{
+    ostringstream s;
+    string b = Balancing::Name(balancing);
+
+    for (int i = 0; i < (int)b.size(); i++)
+    {
+        b[i] = tolower(b[i]);
+    }
+
+    s << name.substr(name.find_last_of('/') + 1) << "." << ranks_count << "." << b << ".ptn";
+
+    return s.str();
+}
@@ -8,12 +8,16 @@
 #include "Lib/MPI/mpi.h"
 #include "Lib/IO/io.h"
 #include <cassert>
+#include <fstream>
+#include <vector>
 
 /*
  * Prototypes.
  */
 void Test_N_To_N_Exchange(int size);
 void Test_N_To_0_To_N_Exchange(int size);
+void Test_Persistent_Exchange(int size);
+void Test_RMA_Exchange(const string &name);
 
 /**
  * \brief Enter point.
@@ -29,7 +33,7 @@ int main(int argc, char **argv)
     MPI_Init(&argc, &argv);
 
     // Analyze test.
-    assert(argc == 2);
+    assert(argc >= 2);
     string test(argv[1]);
     if (test == "n_to_n_exchange")
     {
@@ -45,6 +49,19 @@ int main(int argc, char **argv)
             Test_N_To_0_To_N_Exchange(i);
         }
     }
+    else if (test == "persistent_exchange")
+    {
+        for (int i = 1; i <= 1024; i *= 2)
+        {
+            Test_Persistent_Exchange(i);
+        }
+    }
+    else if (test == "rma_exchange")
+    {
+        // Grid name is needed.
+        assert(argc == 3);
+        Test_RMA_Exchange(argv[2]);
+    }
 
     MPI_Finalize();
 
@@ -242,3 +259,357 @@ void Test_N_To_0_To_N_Exchange(int size)
     delete data;
 }
 
+
+/**
+ * \brief Test exchange of small messages with persistent requests.
+ *
+ * \param[in] size - size of one message (in doubles)
+ *
+ * We have N processes in ring.
+ * Each process sends several messages to left and right neighbours
+ * (as blocks interfaces exchange does) and receives the same messages from them.
+ * Exchange is made with MPI_Isend/MPI_Irecv requests created on each iteration
+ * and with persistent requests created once and started with MPI_Startall.
+ */
+void Test_Persistent_Exchange(int size)
+{
+    const int rank = Lib::MPI::Rank();
+    const int ranks_count = Lib::MPI::Ranks_Count();
+    const int msgs = 16;
+    const int reqs_count = 4 * msgs;
+    const int iters = 1000;
+    const int neighs[2] = { (rank + ranks_count - 1) % ranks_count, (rank + 1) % ranks_count };
+    double *send_data = new double[2 * msgs * size];
+    double *recv_data = new double[2 * msgs * size];
+    Lib::MPI::Timer *timer = new Lib::MPI::Timer();
+    Lib::MPI::Timer *timer_persistent = new Lib::MPI::Timer();
+    MPI_Request *reqs = new MPI_Request[reqs_count];
+    MPI_Request *reqs_persistent = new MPI_Request[reqs_count];
+    MPI_Status *stats = new MPI_Status[reqs_count];
+
+    // Persistent requests.
+    for (int n = 0; n < 2; n++)
+    {
+        for (int m = 0; m < msgs; m++)
+        {
+            int off = (n * msgs + m) * size;
+            int r = 2 * (n * msgs + m);
+
+            // Message m to neighbour n has tag (2 * m + n) and comes from opposite direction.
+            MPI_Recv_init(static_cast<void *>(&recv_data[off]), size, MPI_DOUBLE,
+                          neighs[1 - n], 2 * m + n, MPI_COMM_WORLD, &reqs_persistent[r]);
+            MPI_Send_init(static_cast<void *>(&send_data[off]), size, MPI_DOUBLE,
+                          neighs[n], 2 * m + n, MPI_COMM_WORLD, &reqs_persistent[r + 1]);
+        }
+    }
+
+    // Iterations.
+    for (int iter = 0; iter < 2 * iters; iter++)
+    {
+        bool is_persistent = (iter % 2 == 1);
+
+        // Init.
+        for (int i = 0; i < 2 * msgs * size; i++)
+        {
+            send_data[i] = rank + iter;
+            recv_data[i] = -1.0;
+        }
+
+        // Exchange.
+        if (is_persistent)
+        {
+            timer_persistent->Start();
+            MPI_Startall(reqs_count, reqs_persistent);
+            MPI_Waitall(reqs_count, reqs_persistent, stats);
+            timer_persistent->Stop();
+        }
+        else
+        {
+            timer->Start();
+            for (int n = 0; n < 2; n++)
+            {
+                for (int m = 0; m < msgs; m++)
+                {
+                    int off = (n * msgs + m) * size;
+                    int r = 2 * (n * msgs + m);
+
+                    MPI_Irecv(static_cast<void *>(&recv_data[off]), size, MPI_DOUBLE,
+                              neighs[1 - n], 2 * m + n, MPI_COMM_WORLD, &reqs[r]);
+                    MPI_Isend(static_cast<void *>(&send_data[off]), size, MPI_DOUBLE,
+                              neighs[n], 2 * m + n, MPI_COMM_WORLD, &reqs[r + 1]);
+                }
+            }
+            MPI_Waitall(reqs_count, reqs, stats);
+            timer->Stop();
+        }
+
+        // Check.
+        for (int n = 0; n < 2; n++)
+        {
+            for (int i = 0; i < msgs * size; i++)
+            {
+                assert(recv_data[n * msgs * size + i] == neighs[1 - n] + iter);
+            }
+        }
+    }
+
+    // Print.
+    if (rank == 0)
+    {
+        cout << "Time " << size << ": " << timer->Time()
+             << " (persistent " << timer_persistent->Time() << ")" << endl;
+    }
+
+    for (int i = 0; i < reqs_count; i++)
+    {
+        MPI_Request_free(&reqs_persistent[i]);
+    }
+
+    delete [] stats;
+    delete [] reqs_persistent;
+    delete [] reqs;
+    delete timer_persistent;
+    delete timer;
+    delete [] recv_data;
+    delete [] send_data;
+}
+
+/**
+ * \brief Test shadows exchange of GEOM grid with point-to-point and RMA operations.
+ *
+ * \param[in] name - name of grid (files name.pfg and name.ibc)
+ *
+ * Blocks are distributed between processes as Hydro does it (the biggest block
+ * goes to the most empty process).
+ * Each interface between blocks of different processes is one message of shadow data
+ * (2 layers, 6 doubles for cell) from neighbour block process to block process.
+ * Receive buffer of process keeps messages in order of interfaces file,
+ * so sender knows place of its data in receiver buffer.
+ * Exchange is made with MPI_Isend/MPI_Irecv for each message
+ * and with MPI_Put for each message into window over receive buffer
+ * (post/start/complete/wait synchronization).
+ */
+void Test_RMA_Exchange(const string &name)
+{
+    const int rank = Lib::MPI::Rank();
+    const int ranks_count = Lib::MPI::Ranks_Count();
+    const int doubles_per_cell = 2 * 6;
+    const int iters = 100;
+    ifstream file_pfg((name + ".pfg").c_str());
+    ifstream file_ibc((name + ".ibc").c_str());
+
+    assert(file_pfg.is_open() && file_ibc.is_open());
+
+    if (ranks_count < 2)
+    {
+        cout << "rma_exchange needs at least 2 processes" << endl;
+
+        return;
+    }
+
+    // Blocks.
+    int blocks_count;
+    file_pfg >> blocks_count;
+    vector<int> blocks_cells(blocks_count);
+    for (int i = 0; i < blocks_count; i++)
+    {
+        int i_size, j_size, k_size;
+
+        file_pfg >> i_size >> j_size >> k_size;
+        blocks_cells[i] = (i_size - 1) * (j_size - 1) * (k_size - 1);
+    }
+
+    // Blocks distribution.
+    vector<int> blocks_ranks(blocks_count, -1);
+    vector<int> ranks_cells(ranks_count, 0);
+    for (int iter = 0; iter < blocks_count; iter++)
+    {
+        int big = -1;
+        int emp = 0;
+
+        for (int i = 0; i < blocks_count; i++)
+        {
+            if ((blocks_ranks[i] == -1) && ((big == -1) || (blocks_cells[i] > blocks_cells[big])))
+            {
+                big = i;
+            }
+        }
+        for (int r = 1; r < ranks_count; r++)
+        {
+            if (ranks_cells[r] < ranks_cells[emp])
+            {
+                emp = r;
+            }
+        }
+        blocks_ranks[big] = emp;
+        ranks_cells[emp] += blocks_cells[big];
+    }
+
+    // Messages.
+    string tmp;
+    int ifaces_count;
+    getline(file_ibc, tmp);
+    getline(file_ibc, tmp);
+    file_ibc >> ifaces_count;
+    vector<int> srcs, dsts, sizes, send_offs, recv_offs;
+    vector<int> recv_sizes(ranks_count, 0);
+    vector<bool> is_source(ranks_count, false), is_dest(ranks_count, false);
+    int send_size = 0;
+    for (int i = 0; i < ifaces_count; i++)
+    {
+        int id, bid, i0, i1, j0, j1, k0, k1, nid;
+
+        file_ibc >> id >> bid >> i0 >> i1 >> j0 >> j1 >> k0 >> k1 >> nid;
+
+        int src = blocks_ranks[nid - 1];
+        int dst = blocks_ranks[bid - 1];
+
+        if (src == dst)
+        {
+            continue;
+        }
+
+        int di = (i1 - i0 > 0) ? (i1 - i0) : 1;
+        int dj = (j1 - j0 > 0) ? (j1 - j0) : 1;
+        int dk = (k1 - k0 > 0) ? (k1 - k0) : 1;
+        int size = di * dj * dk * doubles_per_cell;
+
+        srcs.push_back(src);
+        dsts.push_back(dst);
+        sizes.push_back(size);
+        send_offs.push_back(send_size);
+        recv_offs.push_back(recv_sizes[dst]);
+        recv_sizes[dst] += size;
+        if (src == rank)
+        {
+            send_size += size;
+            is_dest[dst] = true;
+        }
+        if (dst == rank)
+        {
+            is_source[src] = true;
+        }
+    }
+    int msgs = static_cast<int>(sizes.size());
+
+    // Buffers, requests, window and groups.
+    double *send_data = new double[send_size + 1];
+    double *recv_data = new double[recv_sizes[rank] + 1];
+    MPI_Request *reqs = new MPI_Request[msgs + 1];
+    Lib::MPI::Timer *timer = new Lib::MPI::Timer();
+    Lib::MPI::Timer *timer_rma = new Lib::MPI::Timer();
+    MPI_Win win;
+    MPI_Group world_group, sources_group, dests_group;
+    vector<int> sources, dests;
+    for (int r = 0; r < ranks_count; r++)
+    {
+        if (is_source[r])
+        {
+            sources.push_back(r);
+        }
+        if (is_dest[r])
+        {
+            dests.push_back(r);
+        }
+    }
+    MPI_Win_create(static_cast<void *>(recv_data), recv_sizes[rank] * sizeof(double),
+                   sizeof(double), MPI_INFO_NULL, MPI_COMM_WORLD, &win);
+    MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+    MPI_Group_incl(world_group, (int)sources.size(), sources.empty() ? NULL : &sources[0],
+                   &sources_group);
+    MPI_Group_incl(world_group, (int)dests.size(), dests.empty() ? NULL : &dests[0],
+                   &dests_group);
+
+    // Iterations.
+    for (int iter = 0; iter < 2 * iters; iter++)
+    {
+        bool is_rma = (iter % 2 == 1);
+        int reqs_count = 0;
+
+        // Init.
+        for (int i = 0; i < send_size; i++)
+        {
+            send_data[i] = rank + iter;
+        }
+        for (int i = 0; i < recv_sizes[rank]; i++)
+        {
+            recv_data[i] = -1.0;
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        // Exchange.
+        if (is_rma)
+        {
+            timer_rma->Start();
+            MPI_Win_post(sources_group, 0, win);
+            MPI_Win_start(dests_group, 0, win);
+            for (int m = 0, off = 0; m < msgs; m++)
+            {
+                if (srcs[m] == rank)
+                {
+                    MPI_Put(static_cast<void *>(&send_data[off]), sizes[m], MPI_DOUBLE,
+                            dsts[m], recv_offs[m], sizes[m], MPI_DOUBLE, win);
+                    off += sizes[m];
+                }
+            }
+            MPI_Win_complete(win);
+            MPI_Win_wait(win);
+            timer_rma->Stop();
+        }
+        else
+        {
+            timer->Start();
+            for (int m = 0, off = 0; m < msgs; m++)
+            {
+                if (dsts[m] == rank)
+                {
+                    MPI_Irecv(static_cast<void *>(&recv_data[recv_offs[m]]), sizes[m], MPI_DOUBLE,
+                              srcs[m], m, MPI_COMM_WORLD, &reqs[reqs_count++]);
+                }
+                if (srcs[m] == rank)
+                {
+                    MPI_Isend(static_cast<void *>(&send_data[off]), sizes[m], MPI_DOUBLE,
+                              dsts[m], m, MPI_COMM_WORLD, &reqs[reqs_count++]);
+                    off += sizes[m];
+                }
+            }
+            MPI_Waitall(reqs_count, reqs, MPI_STATUSES_IGNORE);
+            timer->Stop();
+        }
+
+        // Check.
+        for (int m = 0; m < msgs; m++)
+        {
+            if (dsts[m] == rank)
+            {
+                for (int i = 0; i < sizes[m]; i++)
+                {
+                    assert(recv_data[recv_offs[m] + i] == srcs[m] + iter);
+                }
+            }
+        }
+    }
+
+    // Print.
+    if (rank == 0)
+    {
+        cout << "Messages " << msgs << ", doubles sent by rank 0 " << send_size << endl;
+        cout << "Time: " << timer->Time() << " (rma " << timer_rma->Time() << ")" << endl;
+    }
+
+    MPI_Group_free(&world_group);
+    if (sources_group != MPI_GROUP_EMPTY)
+    {
+        MPI_Group_free(&sources_group);
+    }
+    if (dests_group != MPI_GROUP_EMPTY)
+    {
+        MPI_Group_free(&dests_group);
+    }
+    MPI_Win_free(&win);
+    delete timer_rma;
+    delete timer;
+    delete [] reqs;
+    delete [] recv_data;
+    delete [] send_data;
+}